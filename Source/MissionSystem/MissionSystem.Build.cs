@@ -25,7 +25,15 @@ namespace UnrealBuildTool.Rules
                     "GameplayTags",
                     "DataValidationExtensions",
                     "CoreExtensions",
-                    "ModelViewViewModel"
+                    "ModelViewViewModel",
+                    "NetCore"
+                }
+            );
+
+            PrivateDependencyModuleNames.AddRange(
+                new string[] {
+                    "AssetRegistry",
+                    "TraceLog"
                 }
             );
         }
@@ -0,0 +1,190 @@
+#include "MSActionLatencyTracker.h"
+
+#include "MSMissionAction.h"
+
+const double FMSActionLatencyHistogram::BucketUpperBounds[ BucketCount - 1 ] = { 0.001, 0.01, 0.05, 0.1, 0.25, 0.5, 1.0, 2.0, 5.0, 10.0, 30.0 };
+
+void FMSActionLatencyHistogram::Add( const double seconds )
+{
+    auto bucket_index = 0;
+
+    while ( bucket_index < BucketCount - 1 && seconds > BucketUpperBounds[ bucket_index ] )
+    {
+        ++bucket_index;
+    }
+
+    ++Buckets[ bucket_index ];
+    ++Count;
+    TotalSeconds += seconds;
+    MaxSeconds = FMath::Max( MaxSeconds, seconds );
+}
+
+void FMSActionLatencyHistogram::Append( const FMSActionLatencyHistogram & other )
+{
+    for ( auto bucket_index = 0; bucket_index < BucketCount; ++bucket_index )
+    {
+        Buckets[ bucket_index ] += other.Buckets[ bucket_index ];
+    }
+
+    Count += other.Count;
+    TotalSeconds += other.TotalSeconds;
+    MaxSeconds = FMath::Max( MaxSeconds, other.MaxSeconds );
+}
+
+double FMSActionLatencyHistogram::GetAverage() const
+{
+    return Count > 0 ? TotalSeconds / Count : 0.0;
+}
+
+double FMSActionLatencyHistogram::GetPercentile( const double percentile ) const
+{
+    const auto rank = FMath::Max( 1u, static_cast< uint32 >( FMath::CeilToDouble( percentile * Count ) ) );
+    auto cumulated_count = 0u;
+
+    for ( auto bucket_index = 0; bucket_index < BucketCount - 1; ++bucket_index )
+    {
+        cumulated_count += Buckets[ bucket_index ];
+
+        if ( cumulated_count >= rank )
+        {
+            return FMath::Min( BucketUpperBounds[ bucket_index ], MaxSeconds );
+        }
+    }
+
+    return MaxSeconds;
+}
+
+bool FMSActionLatencyTracker::FOutstandingAction::IsCurrent() const
+{
+    const auto * action = Action.Get();
+    return action != nullptr && action->GetGeneration() == Generation;
+}
+
+void FMSActionLatencyTracker::OnActionStarted( const UMSMissionAction & action, const double time )
+{
+    auto & outstanding_action = OutstandingActions.FindOrAdd( &action );
+    outstanding_action.Action = &action;
+    outstanding_action.Generation = action.GetGeneration();
+    outstanding_action.StartTime = time;
+    outstanding_action.bPassedDeadline = false;
+}
+
+TOptional< FMSActionLatencyTracker::FOutstandingAction > FMSActionLatencyTracker::OnActionFinished( const UMSMissionAction & action, const double time )
+{
+    FOutstandingAction outstanding_action;
+
+    if ( !OutstandingActions.RemoveAndCopyValue( &action, outstanding_action ) || outstanding_action.Generation != action.GetGeneration() )
+    {
+        return {};
+    }
+
+    Histograms.FindOrAdd( action.GetClass()->GetFName() ).Add( time - outstanding_action.StartTime );
+
+    return outstanding_action;
+}
+
+void FMSActionLatencyTracker::OnActionCancelled( const UMSMissionAction & action )
+{
+    OutstandingActions.Remove( &action );
+}
+
+TArray< FMSActionLatencyTracker::FOutstandingAction > FMSActionLatencyTracker::GetActionsPastDeadline( const double time, const double deadline )
+{
+    TArray< FOutstandingAction > actions;
+
+    for ( auto iterator = OutstandingActions.CreateIterator(); iterator; ++iterator )
+    {
+        auto & outstanding_action = iterator.Value();
+
+        if ( !outstanding_action.IsCurrent() )
+        {
+            iterator.RemoveCurrent();
+            continue;
+        }
+
+        if ( !outstanding_action.bPassedDeadline && time - outstanding_action.StartTime > deadline )
+        {
+            outstanding_action.bPassedDeadline = true;
+            actions.Add( outstanding_action );
+        }
+    }
+
+    return actions;
+}
+
+void FMSActionLatencyTracker::Reset()
+{
+    Histograms.Reset();
+    OutstandingActions.Reset();
+}
+
+void FMSActionLatencyTracker::Dump( const TConstArrayView< const FMSActionLatencyTracker * > trackers, const double time, const int32 max_count, FOutputDevice & output_device )
+{
+    TMap< FName, FMSActionLatencyHistogram > histograms;
+    TArray< FOutstandingAction > outstanding_actions;
+
+    for ( const auto * tracker : trackers )
+    {
+        for ( const auto & [ class_name, histogram ] : tracker->Histograms )
+        {
+            histograms.FindOrAdd( class_name ).Append( histogram );
+        }
+
+        for ( const auto & [ action, outstanding_action ] : tracker->OutstandingActions )
+        {
+            if ( outstanding_action.IsCurrent() )
+            {
+                outstanding_actions.Add( outstanding_action );
+            }
+        }
+    }
+
+    histograms.ValueStableSort( []( const FMSActionLatencyHistogram & first, const FMSActionLatencyHistogram & second ) {
+        return first.MaxSeconds > second.MaxSeconds;
+    } );
+
+    outstanding_actions.Sort( []( const FOutstandingAction & first, const FOutstandingAction & second ) {
+        return first.StartTime < second.StartTime;
+    } );
+
+    output_device.Logf( ELogVerbosity::Verbose, TEXT( "Mission System - Slowest actions :" ) );
+
+    auto count = 0;
+
+    for ( const auto & [ class_name, histogram ] : histograms )
+    {
+        if ( max_count > 0 && count++ >= max_count )
+        {
+            break;
+        }
+
+        output_device.Logf( ELogVerbosity::Verbose,
+            TEXT( " * %s : %u executions - average %.3fs - p50 %.3fs - p95 %.3fs - max %.3fs" ),
+            *class_name.ToString(),
+            histogram.Count,
+            histogram.GetAverage(),
+            histogram.GetPercentile( 0.5 ),
+            histogram.GetPercentile( 0.95 ),
+            histogram.MaxSeconds );
+    }
+
+    output_device.Logf( ELogVerbosity::Verbose, TEXT( "Mission System - Outstanding actions :" ) );
+
+    count = 0;
+
+    for ( const auto & outstanding_action : outstanding_actions )
+    {
+        if ( max_count > 0 && count++ >= max_count )
+        {
+            break;
+        }
+
+        const auto * action = outstanding_action.Action.Get();
+
+        output_device.Logf( ELogVerbosity::Verbose,
+            TEXT( " * %s : executed %.3fs ago%s" ),
+            action != nullptr ? *action->GetDescription() : TEXT( "None" ),
+            time - outstanding_action.StartTime,
+            outstanding_action.bPassedDeadline ? TEXT( " - past the deadline" ) : TEXT( "" ) );
+    }
+}
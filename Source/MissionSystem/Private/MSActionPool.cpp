@@ -0,0 +1,63 @@
+#include "MSActionPool.h"
+
+#include "MSMissionAction.h"
+
+FMSActionPool::FMSActionPool() :
+    HitCount( 0 ),
+    MissCount( 0 ),
+    PooledActionCount( 0 )
+{
+}
+
+UMSMissionAction * FMSActionPool::Acquire( UObject * outer, const UMSMissionAction * action_template, const bool use_pool )
+{
+    if ( use_pool )
+    {
+        if ( auto * pooled_actions = PooledActions.Find( action_template ) )
+        {
+            while ( pooled_actions->Actions.Num() > 0 )
+            {
+                auto * action = pooled_actions->Actions.Pop().Get();
+                --PooledActionCount;
+
+                if ( IsValid( action ) )
+                {
+                    ++HitCount;
+                    return action;
+                }
+            }
+        }
+    }
+
+    ++MissCount;
+
+    auto * action = DuplicateObject< UMSMissionAction >( action_template, outer );
+    action->Template = action_template;
+    return action;
+}
+
+void FMSActionPool::Release( UMSMissionAction * action, const int32 max_actions_per_template )
+{
+    if ( !IsValid( action ) || action->Template == nullptr )
+    {
+        return;
+    }
+
+    auto & pooled_actions = PooledActions.FindOrAdd( action->Template );
+
+    if ( pooled_actions.Actions.Num() >= max_actions_per_template )
+    {
+        return;
+    }
+
+    action->ResetAction();
+
+    pooled_actions.Actions.Add( action );
+    ++PooledActionCount;
+}
+
+void FMSActionPool::Reset()
+{
+    PooledActions.Reset();
+    PooledActionCount = 0;
+}
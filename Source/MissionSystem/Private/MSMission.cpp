@@ -3,13 +3,16 @@
 #include "MSLog.h"
 #include "MSMissionAction.h"
 #include "MSMissionData.h"
+#include "MSMissionGraph.h"
 #include "MSMissionObjective.h"
 #include "MSMissionSystemComponent.h"
+#include "MSProfiling.h"
 
 #include <Engine/World.h>
 
 UMSMission::UMSMission() :
     Data( nullptr ),
+    RemainingObjectiveCount( 0 ),
     bIsStarted( false ),
     bIsCancelled( false )
 {
@@ -35,46 +38,133 @@ void UMSMission::Initialize( UMSMissionData * mission_data )
     Data = mission_data;
 
     ActiveObjectives.Reserve( mission_data->Objectives.Num() );
-    PendingObjectives.Reserve( mission_data->Objectives.Num() );
 
     const auto * subsystem = Cast< UMSMissionSystemComponent >( GetOuter() );
     check( subsystem != nullptr );
 
-    const auto & mission_history = subsystem->GetMissionHistory();
+    const auto * mission_graph = subsystem->GetMissionGraph();
+    const auto mission_index = mission_graph != nullptr ? mission_graph->FindMissionIndex( mission_data->GetGuid() ) : INDEX_NONE;
 
-    for ( const auto & objective_data : mission_data->Objectives )
+    InitializeObjectives( subsystem->GetMissionHistory(), mission_index != INDEX_NONE ? mission_graph : nullptr, mission_index );
+
+    StartActionsExecutor.Initialize( this, mission_data->StartActions, [ this ]() {
+        TryStart();
+    } );
+
+    EndActionsExecutor.Initialize( this, mission_data->EndActions, [ this ]() {
+        ensure( IsComplete() || bIsCancelled );
+        ReleaseObjectives();
+        OnMissionEndedEvent.Broadcast( this, bIsCancelled );
+    } );
+}
+
+void UMSMission::InitializeObjectives( const FMSMissionHistory & mission_history, const UMSMissionGraph * mission_graph, const int32 mission_index )
+{
+    // The objectives of mission data created at runtime, by the tests for example, are not compiled when they are loaded
+    if ( Data->GetObjectiveDependencies().GetObjectiveCount() != Data->Objectives.Num() )
+    {
+        Data->CompileObjectiveDependencies();
+    }
+
+    const auto & dependencies = Data->GetObjectiveDependencies();
+    const auto objective_count = Data->Objectives.Num();
+
+    ObjectiveClasses.Reset( objective_count );
+    ObjectiveClasses.SetNum( objective_count );
+    RemainingDependencyCounts.Reset( objective_count );
+    RemainingDependencyCounts.Append( dependencies.GetDependencyCounts() );
+    RunningPrerequisiteCounts.Reset( objective_count );
+    RunningPrerequisiteCounts.Append( dependencies.GetDependencyCounts() );
+    ReadyObjectives.Reset();
+    RemainingObjectiveCount = 0;
+
+    // The history is bound to the mission graph, so it shares the same objective indices, and the finished objectives are found without loading them
+    TArray< int32, TInlineAllocator< 16 > > graph_objective_indices;
+    graph_objective_indices.Init( INDEX_NONE, objective_count );
+
+    if ( mission_graph != nullptr )
     {
-        if ( !objective_data.bEnabled )
+        const auto objective_indices = mission_graph->GetMissionObjectives( mission_index );
+        const auto objective_slots = mission_graph->GetMissionObjectiveSlots( mission_index );
+
+        for ( auto index = 0; index < objective_slots.Num(); ++index )
         {
-            continue;
+            if ( graph_objective_indices.IsValidIndex( objective_slots[ index ] ) )
+            {
+                graph_objective_indices[ objective_slots[ index ] ] = objective_indices[ index ];
+            }
         }
+    }
+
+    // In topological order, the prerequisites of an objective are all known to be finished or pending when it is visited
+    for ( const auto objective_index : dependencies.GetTopologicalOrder() )
+    {
+        const auto & objective_data = Data->Objectives[ objective_index ];
+        const auto graph_objective_index = graph_objective_indices[ objective_index ];
 
-        if ( !ensureAlwaysMsgf( IsValid( objective_data.Objective ), TEXT( "%s has an invalid Mission Objective!" ), *mission_data->GetName() ) )
+        if ( !objective_data.bEnabled || ( graph_objective_index != INDEX_NONE && mission_history.IsObjectiveFinished( graph_objective_index ) ) )
         {
+            ReleaseDependents( objective_index );
+            ReleaseBarriers( objective_index );
             continue;
         }
 
-        if ( mission_history.IsObjectiveFinished( objective_data.Objective ) )
+        // The objective classes are loaded by the prefetcher of the component before the mission starts, so this only loads when the mission is started directly
+        const TSubclassOf< UMSMissionObjective > objective_class = objective_data.Objective.LoadSynchronous();
+
+        if ( !ensureAlwaysMsgf( IsValid( objective_class ), TEXT( "%s has an invalid Mission Objective!" ), *Data->GetName() )
+             || ( graph_objective_index == INDEX_NONE && mission_history.IsObjectiveFinished( objective_class ) ) )
         {
+            ReleaseDependents( objective_index );
+            ReleaseBarriers( objective_index );
             continue;
         }
 
-        if ( CanExecuteObjective( objective_data.Objective ) )
+        ObjectiveClasses[ objective_index ] = objective_class;
+        ++RemainingObjectiveCount;
+
+        if ( CanExecuteObjective( objective_index ) )
         {
-            // Insert in reverse order as objectives to start will be popped out of the list
-            PendingObjectives.Insert( objective_data.Objective, 0 );
+            ReadyObjectives.Add( objective_index );
         }
     }
+}
 
-    StartActionsExecutor.Initialize( this, mission_data->StartActions, [ this ]() {
-        TryStart();
-    } );
+void UMSMission::ReleaseDependents( const int32 objective_index )
+{
+    for ( const auto dependent_index : Data->GetObjectiveDependencies().GetDependents( objective_index ) )
+    {
+        // The dependents which are disabled or already finished have no class
+        if ( --RemainingDependencyCounts[ dependent_index ] == 0 && ObjectiveClasses[ dependent_index ] != nullptr )
+        {
+            ReadyObjectives.Add( dependent_index );
+        }
+    }
+}
 
-    EndActionsExecutor.Initialize( this, mission_data->EndActions, [ this ]() {
-        ensure( IsComplete() || bIsCancelled );
-        ActiveObjectives.Empty();
-        OnMissionEndedEvent.Broadcast( this, bIsCancelled );
-    } );
+void UMSMission::ReleaseBarriers( const int32 objective_index )
+{
+    TArray< UMSMissionObjective *, TInlineAllocator< 4 > > released_objectives;
+
+    for ( const auto dependent_index : Data->GetObjectiveDependencies().GetDependents( objective_index ) )
+    {
+        if ( --RunningPrerequisiteCounts[ dependent_index ] > 0 )
+        {
+            continue;
+        }
+
+        // Only the dependents which already started hold barrier actions
+        if ( auto * const * objective = ActiveObjectivesByIndex.Find( dependent_index ) )
+        {
+            released_objectives.Add( *objective );
+        }
+    }
+
+    // :NOTE: The barrier actions are executed once the loops are over, as the actions which finish immediately can start other objectives
+    for ( auto * objective : released_objectives )
+    {
+        objective->ExecuteBarrierActions();
+    }
 }
 
 void UMSMission::Start()
@@ -106,6 +196,7 @@ void UMSMission::Cancel()
     else
     {
         OnMissionEndedEvent.Broadcast( this, bIsCancelled );
+        ReleaseObjectives();
     }
 }
 
@@ -166,6 +257,7 @@ void UMSMission::OnObjectiveCompleted( UMSMissionObjective * mission_objective,
     }
 
     mission_objective->OnObjectiveEnded().RemoveAll( this );
+    mission_objective->OnObjectiveEndActionsStarted().RemoveAll( this );
     OnMissionObjectiveCompleteEvent.Broadcast( mission_objective->GetClass(), was_cancelled );
 
     if ( bIsCancelled )
@@ -173,10 +265,60 @@ void UMSMission::OnObjectiveCompleted( UMSMissionObjective * mission_objective,
         return;
     }
 
-    if ( !was_cancelled )
+    // A cancelled objective never releases its dependents, so the mission stops there, like a mission which runs its objectives one at a time.
+    // In a parallel group, the next group does not start, even if the cancelled objective is the last member of the group to end.
+    // The other running objectives can still complete, and the objectives which do not depend on the cancelled one can still start
+    if ( was_cancelled )
+    {
+        return;
+    }
+
+    --RemainingObjectiveCount;
+
+    if ( const auto * objective_index = ActiveObjectiveIndices.Find( mission_objective ) )
+    {
+        // When the objectives are pipelined, the dependents were released when the end actions started
+        if ( !Data->bPipelineObjectiveActions )
+        {
+            ReleaseDependents( *objective_index );
+        }
+
+        ReleaseBarriers( *objective_index );
+    }
+
+    ScheduleNextObjective();
+}
+
+void UMSMission::OnObjectiveEndActionsStarted( UMSMissionObjective * mission_objective )
+{
+    mission_objective->OnObjectiveEndActionsStarted().RemoveAll( this );
+
+    if ( !bIsStarted || bIsCancelled )
+    {
+        return;
+    }
+
+    if ( const auto * objective_index = ActiveObjectiveIndices.Find( mission_objective ) )
+    {
+        ReleaseDependents( *objective_index );
+    }
+
+    ScheduleNextObjective();
+}
+
+void UMSMission::ScheduleNextObjective()
+{
+    // Nothing can start until another running objective ends
+    if ( ReadyObjectives.Num() == 0 && RemainingObjectiveCount > 0 )
     {
-        ExecuteNextObjective();
+        return;
     }
+
+    auto * component = Cast< UMSMissionSystemComponent >( GetOuter() );
+    check( component != nullptr );
+
+    // :NOTE: When the scheduler is already draining, the next objective is queued instead of being executed from within the broadcast of the objective which just ended
+    component->ScheduleTransition( FMSMissionTransition::MakeExecuteNextObjective( this ) );
 }
 
 void UMSMission::TryStart()
@@ -199,39 +341,113 @@ void UMSMission::TryEnd()
     }
 }
 
+void UMSMission::ReleaseObjectives()
+{
+    auto * component = Cast< UMSMissionSystemComponent >( GetOuter() );
+    check( component != nullptr );
+
+    for ( auto objective : ActiveObjectives )
+    {
+        // Objectives which still run actions are left to the garbage collector, as the actions can finish after the objective is reused
+        if ( objective->HasEnded() && !objective->HasExecutingActions() )
+        {
+            objective->ReleaseActions();
+            component->ReleaseObjective( objective );
+        }
+    }
+
+    ActiveObjectives.Empty();
+    ActiveObjectiveIndices.Empty();
+    ActiveObjectivesByIndex.Empty();
+
+    StartActionsExecutor.Release();
+    EndActionsExecutor.Release();
+}
+
 void UMSMission::ExecuteNextObjective()
 {
-    if ( PendingObjectives.Num() > 0 )
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_ExecuteObjective );
+
+    if ( ReadyObjectives.Num() == 0 )
     {
-        auto objective_class = PendingObjectives.Pop();
+        if ( RemainingObjectiveCount == 0 )
+        {
+            TryEnd();
+        }
+
+        return;
+    }
+
+    auto * component = Cast< UMSMissionSystemComponent >( GetOuter() );
+    check( component != nullptr );
 
-        if ( !CanExecuteObjective( objective_class ) )
+    // :NOTE: Move the ready objectives out, as the objectives which complete immediately make their dependents ready, which are started by another transition
+    const auto ready_objectives = MoveTemp( ReadyObjectives );
+    ReadyObjectives.Reset();
+
+    auto has_ignored_objectives = false;
+
+    for ( const auto objective_index : ready_objectives )
+    {
+        // An objective can cancel the mission when it starts
+        if ( bIsCancelled )
         {
-            ExecuteNextObjective();
             return;
         }
 
-        auto * objective = NewObject< UMSMissionObjective >( this, objective_class );
+        const auto & objective_class = ObjectiveClasses[ objective_index ];
+
+        // The tags are set in the class defaults, so the ignored objectives are never instanced
+        if ( component->MustObjectiveBeIgnored( objective_class.GetDefaultObject() ) )
+        {
+            IgnoreObjective( objective_index );
+            has_ignored_objectives = true;
+            continue;
+        }
+
+        MS_TRACE_NAMED_SCOPE( "ExecuteObjective", FMSTrace::GetObjectName( objective_class.Get() ) );
+
+        auto * objective = component->AcquireObjective( this, objective_class );
         ActiveObjectives.Add( objective );
+        ActiveObjectiveIndices.Add( objective, objective_index );
+        ActiveObjectivesByIndex.Add( objective_index, objective );
 
         objective->OnObjectiveEnded().AddUObject( this, &UMSMission::OnObjectiveCompleted );
 
+        if ( Data->bPipelineObjectiveActions )
+        {
+            objective->OnObjectiveEndActionsStarted().AddUObject( this, &UMSMission::OnObjectiveEndActionsStarted );
+        }
+
         UE_LOG( LogMissionSystem, Verbose, TEXT( "Execute objective %s" ), *objective->GetClass()->GetName() );
 
-        objective->Execute();
+        // When pipelined, the objective can start while the end actions of its prerequisites are still running
+        objective->Execute( Data->bPipelineObjectiveActions && RunningPrerequisiteCounts[ objective_index ] > 0 );
         OnMissionObjectiveStartedEvent.Broadcast( objective->GetClass() );
     }
-    else
+
+    if ( has_ignored_objectives && !bIsCancelled )
     {
-        TryEnd();
+        ScheduleNextObjective();
     }
 }
 
-bool UMSMission::CanExecuteObjective( const TSubclassOf< UMSMissionObjective > & objective_class ) const
+void UMSMission::IgnoreObjective( const int32 objective_index )
 {
-#if !( UE_BUILD_SHIPPING || UE_BUILD_TEST )
-    // :TODO:
-#endif
+    const auto & objective_class = ObjectiveClasses[ objective_index ];
 
-    return true;
+    UE_LOG( LogMissionSystem, Verbose, TEXT( "Ignore objective %s" ), *objective_class->GetName() );
+
+    // Like the running objectives completed by IgnoreObjectivesWithTags, the objective is saved as complete in the history
+    OnMissionObjectiveStartedEvent.Broadcast( objective_class );
+    OnMissionObjectiveCompleteEvent.Broadcast( objective_class, false );
+
+    --RemainingObjectiveCount;
+    ReleaseDependents( objective_index );
+    ReleaseBarriers( objective_index );
+}
+
+bool UMSMission::CanExecuteObjective( const int32 objective_index ) const
+{
+    return RemainingDependencyCounts[ objective_index ] == 0;
 }
\ No newline at end of file
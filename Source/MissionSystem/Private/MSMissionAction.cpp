@@ -1,14 +1,80 @@
 #include "MSMissionAction.h"
 
+#include "MSMissionObjective.h"
+
+#include <UObject/UnrealType.h>
+
+UMSMissionAction::UMSMissionAction() :
+    bIsPipelineBarrier( false ),
+    Generation( 0 )
+{
+}
+
 void UMSMissionAction::Execute_Implementation()
 {
 }
 
+void UMSMissionAction::K2_OnReset_Implementation()
+{
+}
+
 void UMSMissionAction::Initialize( UObject * world_context )
 {
     Outer = world_context;
 }
 
+void UMSMissionAction::ResetAction()
+{
+    OnMissionActionCompleteEvent.Clear();
+    Outer.Reset();
+    ++Generation;
+
+    K2_OnReset();
+    RestoreTemplateProperties();
+}
+
+void UMSMissionAction::RestoreTemplateProperties()
+{
+    const auto * source = Template != nullptr ? Template.Get() : Cast< UMSMissionAction >( GetArchetype() );
+
+    if ( source == nullptr || source == this || source->GetClass() != GetClass() )
+    {
+        return;
+    }
+
+    for ( TFieldIterator< FProperty > iterator( GetClass() ); iterator; ++iterator )
+    {
+        const auto * property = *iterator;
+
+        // The properties of the base class are reset above, or are only edited in the templates
+        if ( property->GetOwnerClass() == StaticClass() || property->HasAnyPropertyFlags( CPF_InstancedReference | CPF_ContainsInstancedReference ) )
+        {
+            continue;
+        }
+
+        property->CopyCompleteValue_InContainer( this, source );
+    }
+}
+
+FString UMSMissionAction::GetDescription() const
+{
+    // The actions of the objectives are executed without a copy, so they have no template
+    const UObject * template_owner = Template != nullptr ? Template->GetOuter() : GetOuter();
+
+    // The actions are instanced in the mission data, or in each objective
+    if ( template_owner != nullptr && template_owner->IsA< UMSMissionObjective >() )
+    {
+        template_owner = template_owner->GetClass();
+    }
+
+    if ( template_owner == nullptr )
+    {
+        return GetClass()->GetName();
+    }
+
+    return FString::Printf( TEXT( "%s (%s)" ), *GetClass()->GetName(), *template_owner->GetName() );
+}
+
 void UMSMissionAction::FinishExecute()
 {
     OnMissionActionCompleteEvent.Broadcast( this );
@@ -0,0 +1,239 @@
+#include "MSMissionCatalogSubsystem.h"
+
+#include "MSLog.h"
+#include "MSMissionData.h"
+
+#include <AssetRegistry/ARFilter.h>
+#include <AssetRegistry/AssetData.h>
+#include <AssetRegistry/IAssetRegistry.h>
+#include <Engine/Blueprint.h>
+#include <Engine/BlueprintGeneratedClass.h>
+#include <Engine/Engine.h>
+#include <Misc/PackageName.h>
+
+namespace
+{
+    const FName MissionIdTagName( TEXT( "MissionId" ) );
+    const FName ObjectiveIdTagName( TEXT( "ObjectiveId" ) );
+
+    bool GetGuidTagValue( const FAssetData & asset_data, const FName tag_name, FGuid & guid )
+    {
+        FString tag_value;
+        return asset_data.GetTagValue( tag_name, tag_value ) && FGuid::Parse( tag_value, guid ) && guid.IsValid();
+    }
+}
+
+UMSMissionCatalogSubsystem * UMSMissionCatalogSubsystem::Get()
+{
+    return GEngine != nullptr ? GEngine->GetEngineSubsystem< UMSMissionCatalogSubsystem >() : nullptr;
+}
+
+void UMSMissionCatalogSubsystem::Initialize( FSubsystemCollectionBase & collection )
+{
+    Super::Initialize( collection );
+
+    auto * asset_registry = IAssetRegistry::Get();
+
+    if ( !ensureAlways( asset_registry != nullptr ) )
+    {
+        return;
+    }
+
+    asset_registry->OnAssetAdded().AddUObject( this, &UMSMissionCatalogSubsystem::OnAssetAdded );
+    asset_registry->OnAssetUpdated().AddUObject( this, &UMSMissionCatalogSubsystem::OnAssetAdded );
+    asset_registry->OnAssetRemoved().AddUObject( this, &UMSMissionCatalogSubsystem::OnAssetRemoved );
+    asset_registry->OnFilesLoaded().AddUObject( this, &UMSMissionCatalogSubsystem::Rebuild );
+
+    Rebuild();
+}
+
+void UMSMissionCatalogSubsystem::Deinitialize()
+{
+    if ( auto * asset_registry = IAssetRegistry::Get() )
+    {
+        asset_registry->OnAssetAdded().RemoveAll( this );
+        asset_registry->OnAssetUpdated().RemoveAll( this );
+        asset_registry->OnAssetRemoved().RemoveAll( this );
+        asset_registry->OnFilesLoaded().RemoveAll( this );
+    }
+
+    MissionPaths.Reset();
+    ObjectivePaths.Reset();
+    ObjectiveIds.Reset();
+
+    Super::Deinitialize();
+}
+
+FSoftObjectPath UMSMissionCatalogSubsystem::GetMissionPath( const FGuid & mission_id ) const
+{
+    if ( const auto * path = MissionPaths.Find( mission_id ) )
+    {
+        return *path;
+    }
+
+    return {};
+}
+
+FSoftClassPath UMSMissionCatalogSubsystem::GetObjectivePath( const FGuid & objective_id ) const
+{
+    if ( const auto * path = ObjectivePaths.Find( objective_id ) )
+    {
+        return *path;
+    }
+
+    return {};
+}
+
+FGuid UMSMissionCatalogSubsystem::GetObjectiveId( const UClass * objective_class ) const
+{
+    if ( objective_class == nullptr || ObjectiveIds.IsEmpty() )
+    {
+        return {};
+    }
+
+    if ( const auto * objective_id = ObjectiveIds.Find( FSoftClassPath( objective_class ) ) )
+    {
+        return *objective_id;
+    }
+
+    return {};
+}
+
+UMSMissionData * UMSMissionCatalogSubsystem::LoadMissionData( const FGuid & mission_id ) const
+{
+    const auto * path = MissionPaths.Find( mission_id );
+
+    if ( path == nullptr )
+    {
+        UE_LOG( LogMissionSystem, Warning, TEXT( "No mission data found in the catalog with the ID %s" ), *mission_id.ToString() );
+        return nullptr;
+    }
+
+    return Cast< UMSMissionData >( path->TryLoad() );
+}
+
+void UMSMissionCatalogSubsystem::AddMissionData( const UMSMissionData * mission_data )
+{
+    if ( mission_data != nullptr && mission_data->GetGuid().IsValid() )
+    {
+        MissionPaths.Add( mission_data->GetGuid(), FSoftObjectPath( mission_data ) );
+    }
+}
+
+void UMSMissionCatalogSubsystem::Rebuild()
+{
+    const auto * asset_registry = IAssetRegistry::Get();
+
+    if ( asset_registry == nullptr )
+    {
+        return;
+    }
+
+    TArray< FAssetData > assets;
+
+    FARFilter mission_filter;
+    mission_filter.ClassPaths.Add( UMSMissionData::StaticClass()->GetClassPathName() );
+
+    asset_registry->GetAssets( mission_filter, assets );
+
+    for ( const auto & asset_data : assets )
+    {
+        AddMissionAsset( asset_data );
+    }
+
+    assets.Reset();
+
+    // Objectives are blueprints in the editor, and blueprint generated classes in cooked builds
+    FARFilter objective_filter;
+    objective_filter.ClassPaths.Add( UBlueprint::StaticClass()->GetClassPathName() );
+    objective_filter.ClassPaths.Add( UBlueprintGeneratedClass::StaticClass()->GetClassPathName() );
+    objective_filter.bRecursiveClasses = true;
+    objective_filter.TagsAndValues.Add( ObjectiveIdTagName );
+
+    asset_registry->GetAssets( objective_filter, assets );
+
+    for ( const auto & asset_data : assets )
+    {
+        AddObjectiveAsset( asset_data );
+    }
+
+    UE_LOG( LogMissionSystem, Verbose, TEXT( "Mission catalog built with %d missions and %d objectives" ), MissionPaths.Num(), ObjectivePaths.Num() );
+}
+
+void UMSMissionCatalogSubsystem::OnAssetAdded( const FAssetData & asset_data )
+{
+    if ( const auto * asset_registry = IAssetRegistry::Get(); asset_registry != nullptr && asset_registry->IsLoadingAssets() )
+    {
+        // Rebuild will be called once all the files have been discovered
+        return;
+    }
+
+    if ( asset_data.IsInstanceOf( UMSMissionData::StaticClass() ) )
+    {
+        AddMissionAsset( asset_data );
+    }
+    else
+    {
+        AddObjectiveAsset( asset_data );
+    }
+}
+
+void UMSMissionCatalogSubsystem::OnAssetRemoved( const FAssetData & asset_data )
+{
+    FGuid id;
+
+    if ( GetGuidTagValue( asset_data, MissionIdTagName, id ) )
+    {
+        MissionPaths.Remove( id );
+    }
+    else if ( GetGuidTagValue( asset_data, ObjectiveIdTagName, id ) )
+    {
+        if ( const auto * class_path = ObjectivePaths.Find( id ) )
+        {
+            ObjectiveIds.Remove( *class_path );
+        }
+
+        ObjectivePaths.Remove( id );
+    }
+}
+
+void UMSMissionCatalogSubsystem::AddMissionAsset( const FAssetData & asset_data )
+{
+    FGuid mission_id;
+
+    if ( GetGuidTagValue( asset_data, MissionIdTagName, mission_id ) )
+    {
+        MissionPaths.Add( mission_id, asset_data.GetSoftObjectPath() );
+    }
+}
+
+void UMSMissionCatalogSubsystem::AddObjectiveAsset( const FAssetData & asset_data )
+{
+    FGuid objective_id;
+
+    if ( !GetGuidTagValue( asset_data, ObjectiveIdTagName, objective_id ) )
+    {
+        return;
+    }
+
+    FSoftClassPath class_path;
+
+    if ( asset_data.IsInstanceOf( UBlueprintGeneratedClass::StaticClass() ) )
+    {
+        class_path = FSoftClassPath( asset_data.GetSoftObjectPath().ToString() );
+    }
+    else
+    {
+        FString generated_class_path;
+
+        if ( !asset_data.GetTagValue( FBlueprintTags::GeneratedClassPath, generated_class_path ) )
+        {
+            return;
+        }
+
+        class_path = FSoftClassPath( FPackageName::ExportTextPathToObjectPath( generated_class_path ) );
+    }
+
+    ObjectivePaths.Add( objective_id, class_path );
+    ObjectiveIds.Add( class_path, objective_id );
+}
@@ -1,30 +1,48 @@
 #include "MSMissionData.h"
 
 #include "DVEDataValidator.h"
+#include "MSLog.h"
+
+#if WITH_EDITOR
+#include <UObject/ObjectSaveContext.h>
+#endif
 
 FMSMissionObjectiveData::FMSMissionObjectiveData()
 {
     bEnabled = true;
+    bStartWithPreviousObjective = false;
 }
 
 FMSMissionObjectiveData::FMSMissionObjectiveData( const TSubclassOf< UMSMissionObjective > & objective, const bool enabled /*= true*/ ) :
-    Objective( objective ),
-    bEnabled( enabled )
+    Objective( objective.Get() ),
+    bEnabled( enabled ),
+    bStartWithPreviousObjective( false )
 {
 }
 
 UMSMissionData::UMSMissionData() :
     bEnabled( true ),
     bExecuteEndActionsWhenCancelled( true ),
-    bStartNextMissionsWhenCancelled( false )
+    bStartNextMissionsWhenCancelled( false ),
+    bPipelineObjectiveActions( false ),
+    Priority( EMSMissionTransitionPriority::Normal )
 {
 }
 
+void UMSMissionData::CompileObjectiveDependencies()
+{
+    if ( !ObjectiveDependencies.Build( Objectives ) )
+    {
+        UE_LOG( LogMissionSystem, Error, TEXT( "The prerequisites of the objectives of %s contain a cycle. The objectives run in the order of the list" ), *GetPathName() );
+    }
+}
+
 void UMSMissionData::PostLoad()
 {
     Super::PostLoad();
 
     GenerateGuidIfNeeded();
+    CompileObjectiveDependencies();
 }
 
 void UMSMissionData::PostDuplicate( bool duplicate_for_pie )
@@ -42,6 +60,20 @@ void UMSMissionData::PostEditImport()
 }
 
 #if WITH_EDITOR
+void UMSMissionData::PreSave( const FObjectPreSaveContext object_save_context )
+{
+    CompileObjectiveDependencies();
+
+    Super::PreSave( object_save_context );
+}
+
+void UMSMissionData::PostEditChangeProperty( FPropertyChangedEvent & property_changed_event )
+{
+    Super::PostEditChangeProperty( property_changed_event );
+
+    CompileObjectiveDependencies();
+}
+
 EDataValidationResult UMSMissionData::IsDataValid( FDataValidationContext & context ) const
 {
     Super::IsDataValid( context );
@@ -49,15 +81,42 @@ EDataValidationResult UMSMissionData::IsDataValid( FDataValidationContext & cont
     return FDVEDataValidator( context )
         .NoNullItem( VALIDATOR_GET_PROPERTY( StartActions ) )
         .NoNullItem( VALIDATOR_GET_PROPERTY( EndActions ) )
-        .NoNullItem( VALIDATOR_GET_PROPERTY( NextMissions ) )
         .IsValid( VALIDATOR_GET_PROPERTY( MissionId ) )
+        .CustomValidation< TArray< TSoftObjectPtr< UMSMissionData > > >( NextMissions, []( FDataValidationContext & context, const TArray< TSoftObjectPtr< UMSMissionData > > & next_missions ) {
+            for ( const auto & next_mission : next_missions )
+            {
+                if ( next_mission.IsNull() )
+                {
+                    context.AddError( FText::FromString( TEXT( "NextMissions contains an invalid mission" ) ) );
+                }
+            }
+        } )
         .CustomValidation< TArray< FMSMissionObjectiveData > >( Objectives, []( FDataValidationContext & context, const TArray< FMSMissionObjectiveData > & objectives ) {
             for ( const auto & objective_data : objectives )
             {
-                if ( objective_data.Objective == nullptr )
+                if ( objective_data.Objective.IsNull() )
                 {
                     context.AddError( FText::FromString( TEXT( "Objectives contains an invalid objective" ) ) );
                 }
+
+                for ( const auto & prerequisite : objective_data.Prerequisites )
+                {
+                    if ( prerequisite == objective_data.Objective )
+                    {
+                        context.AddError( FText::FromString( FString::Printf( TEXT( "%s is a prerequisite of itself" ), *objective_data.Objective.GetAssetName() ) ) );
+                    }
+                    else if ( !objectives.ContainsByPredicate( [ &prerequisite ]( const FMSMissionObjectiveData & other_objective_data ) {
+                                  return other_objective_data.Objective == prerequisite;
+                              } ) )
+                    {
+                        context.AddError( FText::FromString( FString::Printf( TEXT( "The prerequisite %s of %s is not an objective of the mission" ), *prerequisite.GetAssetName(), *objective_data.Objective.GetAssetName() ) ) );
+                    }
+                }
+            }
+
+            if ( FMSObjectiveDependencies dependencies; !dependencies.Build( objectives ) )
+            {
+                context.AddError( FText::FromString( TEXT( "The prerequisites of the objectives contain a cycle" ) ) );
             }
         } )
         .Result();
@@ -0,0 +1,20 @@
+#include "MSMissionEvents.h"
+
+#include "MSMission.h"
+
+FMSMissionEvent::FMSMissionEvent() :
+    Type( EMSMissionEventType::MissionStarted ),
+    Mission( nullptr ),
+    MissionData( nullptr ),
+    bWasCancelled( false )
+{
+}
+
+FMSMissionEvent::FMSMissionEvent( const EMSMissionEventType type, UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective, const bool was_cancelled ) :
+    Type( type ),
+    Mission( mission ),
+    MissionData( mission != nullptr ? mission->GetMissionData() : nullptr ),
+    Objective( objective ),
+    bWasCancelled( was_cancelled )
+{
+}
@@ -0,0 +1,224 @@
+#include "MSMissionGraph.h"
+
+#include "MSLog.h"
+#include "MSMissionData.h"
+
+#if WITH_EDITOR
+#include <AssetRegistry/ARFilter.h>
+#include <AssetRegistry/AssetData.h>
+#include <AssetRegistry/IAssetRegistry.h>
+#include <UObject/ObjectSaveContext.h>
+#endif
+
+FMSCompiledMission::FMSCompiledMission() :
+    FirstObjective( 0 ),
+    ObjectiveCount( 0 ),
+    FirstNextMission( 0 ),
+    NextMissionCount( 0 ),
+    FirstMissionToCancel( 0 ),
+    MissionToCancelCount( 0 ),
+    bEnabled( true )
+{
+}
+
+UMSMissionData * UMSMissionGraph::LoadMissionData( const int32 mission_index ) const
+{
+    return Missions[ mission_index ].MissionData.LoadSynchronous();
+}
+
+void UMSMissionGraph::PostLoad()
+{
+    Super::PostLoad();
+
+    BuildIndices();
+}
+
+#if WITH_EDITOR
+void UMSMissionGraph::PreSave( const FObjectPreSaveContext object_save_context )
+{
+    // Compile each time the graph is saved or cooked, so it never gets out of sync with the mission data
+    Compile();
+
+    Super::PreSave( object_save_context );
+}
+
+void UMSMissionGraph::Compile()
+{
+    auto & asset_registry = IAssetRegistry::GetChecked();
+    asset_registry.WaitForCompletion();
+
+    FARFilter filter;
+    filter.ClassPaths.Add( UMSMissionData::StaticClass()->GetClassPathName() );
+
+    TArray< FAssetData > assets;
+    asset_registry.GetAssets( filter, assets );
+
+    TArray< UMSMissionData * > missions;
+    missions.Reserve( assets.Num() );
+
+    for ( const auto & asset_data : assets )
+    {
+        if ( auto * mission_data = Cast< UMSMissionData >( asset_data.GetAsset() ) )
+        {
+            missions.Add( mission_data );
+        }
+    }
+
+    Compile( missions );
+}
+
+void UMSMissionGraph::Compile( const TArray< UMSMissionData * > & missions )
+{
+    // Also compile the missions referenced by the given missions
+    TSet< UMSMissionData * > visited_missions;
+    auto missions_to_visit = missions;
+
+    while ( missions_to_visit.Num() > 0 )
+    {
+        auto * mission_data = missions_to_visit.Pop();
+
+        if ( mission_data == nullptr || visited_missions.Contains( mission_data ) )
+        {
+            continue;
+        }
+
+        visited_missions.Add( mission_data );
+
+        // The graph is only compiled in the editor, where the referenced missions can be loaded synchronously
+        for ( const auto & next_mission : mission_data->NextMissions )
+        {
+            missions_to_visit.Add( next_mission.LoadSynchronous() );
+        }
+
+        for ( const auto & mission_to_cancel : mission_data->MissionsToCancel )
+        {
+            missions_to_visit.Add( mission_to_cancel.LoadSynchronous() );
+        }
+    }
+
+    // Sort the missions to get the same graph each time it is compiled
+    auto sorted_missions = visited_missions.Array();
+    sorted_missions.Sort( []( const UMSMissionData & left, const UMSMissionData & right ) {
+        return left.GetPathName() < right.GetPathName();
+    } );
+
+    Modify();
+
+    if ( !GraphId.IsValid() )
+    {
+        GraphId = FGuid::NewGuid();
+    }
+
+    // Keep the index of the missions and objectives of the previous compilation. The ones which were removed keep their ID, and get no data
+    Missions.Reset( FMath::Max( MissionIds.Num(), sorted_missions.Num() ) );
+    Missions.SetNum( MissionIds.Num() );
+
+    for ( auto & compiled_mission : Missions )
+    {
+        compiled_mission.bEnabled = false;
+    }
+
+    Objectives.Reset( ObjectiveIds.Num() );
+    Objectives.SetNum( ObjectiveIds.Num() );
+    MissionObjectives.Reset();
+    MissionObjectiveSlots.Reset();
+    NextMissionEdges.Reset();
+    MissionToCancelEdges.Reset();
+    BuildIndices();
+
+    TMap< UMSMissionData *, int32 > mission_indices;
+
+    for ( auto * mission_data : sorted_missions )
+    {
+        auto & mission_index = MissionIndices.FindOrAdd( mission_data->GetGuid(), INDEX_NONE );
+
+        if ( mission_index == INDEX_NONE )
+        {
+            mission_index = MissionIds.Add( mission_data->GetGuid() );
+            Missions.AddDefaulted();
+        }
+        else if ( !Missions[ mission_index ].MissionData.IsNull() )
+        {
+            UE_LOG( LogMissionSystem, Error, TEXT( "%s has the same ID as another mission and is ignored by the mission graph" ), *mission_data->GetPathName() );
+            continue;
+        }
+
+        mission_indices.Add( mission_data, mission_index );
+
+        // Set right away, to detect the missions which share the same ID
+        Missions[ mission_index ].MissionData = TSoftObjectPtr< UMSMissionData >( mission_data );
+    }
+
+    const auto add_mission_edges = [ & ]( const TArray< TSoftObjectPtr< UMSMissionData > > & linked_missions, TArray< int32 > & edges, int32 & first_edge, int32 & edge_count ) {
+        first_edge = edges.Num();
+
+        for ( const auto & linked_mission : linked_missions )
+        {
+            if ( const auto * linked_mission_index = mission_indices.Find( linked_mission.Get() ) )
+            {
+                edges.Add( *linked_mission_index );
+            }
+        }
+
+        edge_count = edges.Num() - first_edge;
+    };
+
+    for ( const auto & [ mission_data, mission_index ] : mission_indices )
+    {
+        auto & compiled_mission = Missions[ mission_index ];
+        compiled_mission.bEnabled = mission_data->bEnabled;
+        compiled_mission.FirstObjective = MissionObjectives.Num();
+
+        for ( auto slot = 0; slot < mission_data->Objectives.Num(); ++slot )
+        {
+            const auto & objective_data = mission_data->Objectives[ slot ];
+            const TSubclassOf< UMSMissionObjective > objective_class = objective_data.bEnabled ? objective_data.Objective.LoadSynchronous() : nullptr;
+
+            if ( objective_class == nullptr )
+            {
+                continue;
+            }
+
+            const auto & objective_id = objective_class.GetDefaultObject()->GetGuid();
+            auto & objective_index = ObjectiveIndices.FindOrAdd( objective_id, INDEX_NONE );
+
+            if ( objective_index == INDEX_NONE )
+            {
+                objective_index = ObjectiveIds.Add( objective_id );
+                Objectives.AddDefaulted();
+            }
+
+            Objectives[ objective_index ] = objective_data.Objective;
+
+            MissionObjectives.Add( objective_index );
+            MissionObjectiveSlots.Add( slot );
+        }
+
+        compiled_mission.ObjectiveCount = MissionObjectives.Num() - compiled_mission.FirstObjective;
+
+        add_mission_edges( mission_data->NextMissions, NextMissionEdges, compiled_mission.FirstNextMission, compiled_mission.NextMissionCount );
+        add_mission_edges( mission_data->MissionsToCancel, MissionToCancelEdges, compiled_mission.FirstMissionToCancel, compiled_mission.MissionToCancelCount );
+    }
+
+    UE_LOG( LogMissionSystem, Log, TEXT( "Compiled mission graph %s : %d missions, %d objectives" ), *GetPathName(), mission_indices.Num(), Objectives.Num() );
+}
+#endif
+
+void UMSMissionGraph::BuildIndices()
+{
+    MissionIndices.Reset();
+    MissionIndices.Reserve( MissionIds.Num() );
+
+    for ( auto index = 0; index < MissionIds.Num(); ++index )
+    {
+        MissionIndices.Add( MissionIds[ index ], index );
+    }
+
+    ObjectiveIndices.Reset();
+    ObjectiveIndices.Reserve( ObjectiveIds.Num() );
+
+    for ( auto index = 0; index < ObjectiveIds.Num(); ++index )
+    {
+        ObjectiveIndices.Add( ObjectiveIds[ index ], index );
+    }
+}
@@ -1,6 +1,21 @@
 #include "MSMissionHistory.h"
 
+#include "MSLog.h"
+#include "MSMissionCatalogSubsystem.h"
 #include "MSMissionData.h"
+#include "MSMissionGraph.h"
+#include "MSMissionHistoryVersion.h"
+
+#include <HAL/IConsoleManager.h>
+#include <Misc/Compression.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+
+static TAutoConsoleVariable< bool > CVarCompressMissionHistory(
+    TEXT( "MissionSystem.CompressHistory" ),
+    false,
+    TEXT( "Set to true to compress the mission history when it is saved. Compressed and uncompressed histories can both be loaded." ),
+    ECVF_Default );
 
 namespace
 {
@@ -16,58 +31,75 @@ namespace
     template <>
     FGuid GetGuid( TSubclassOf< UMSMissionObjective > object )
     {
+        // The classes which were already instantiated have a CDO, which avoids building the path of the class to look it up in the catalog
+        if ( const auto * cdo = Cast< UMSMissionObjective >( object->GetDefaultObject( false ) ) )
+        {
+            return cdo->GetGuid();
+        }
+
+        // Ask the catalog before creating the CDO of the objective
+        if ( const auto * catalog = UMSMissionCatalogSubsystem::Get() )
+        {
+            const auto objective_id = catalog->GetObjectiveId( object );
+
+            if ( objective_id.IsValid() )
+            {
+                return objective_id;
+            }
+        }
+
         auto * cdo = object.GetDefaultObject();
         return cdo->GetGuid();
     }
 
     template < typename _ObjectType_ >
-    TOptional< EMSState > GetState( _ObjectType_ object, const TMap< FGuid, EMSState > & object_map )
+    int32 FindIndex( _ObjectType_ object, const FMSMissionStateTable & table )
     {
         if ( object == nullptr )
         {
-            return {};
+            return INDEX_NONE;
         }
 
         const auto guid = GetGuid( object );
 
         if ( !ensureAlways( guid.IsValid() ) )
         {
-            return {};
-        }
-
-        if ( auto * state = object_map.Find( guid ) )
-        {
-            return *state;
+            return INDEX_NONE;
         }
 
-        return {};
+        return table.FindIndex( guid );
     }
 
     template < typename _ObjectType_ >
-    bool DoesHaveState( _ObjectType_ object, const TMap< FGuid, EMSState > & object_map, EMSState required_state )
+    bool TryAddToTable( _ObjectType_ object, FMSMissionStateTable & table, TSet< FGuid > & changed_ids )
     {
-        if ( object == nullptr )
+        if ( !ensureAlways( object != nullptr ) )
         {
             return false;
         }
 
-        const auto guid = GetGuid( object );
+        const auto id = GetGuid( object );
 
-        if ( !ensureAlways( guid.IsValid() ) )
+        if ( !ensureAlways( id.IsValid() ) )
         {
             return false;
         }
 
-        if ( auto * state = object_map.Find( guid ) )
+        const auto index = table.FindOrAddIndex( id );
+
+        if ( const auto state = table.GetState( index ) )
         {
-            return *state == required_state;
+            return state.GetValue() == EMSState::Active;
         }
 
-        return false;
+        table.SetState( index, EMSState::Active );
+        changed_ids.Add( id );
+
+        return true;
     }
 
     template < typename _ObjectType_ >
-    bool TryAddToMap( _ObjectType_ object, TMap< FGuid, EMSState > & object_map )
+    bool SetComplete( _ObjectType_ object, FMSMissionStateTable & table, TSet< FGuid > & changed_ids, const bool was_cancelled )
     {
         if ( !ensureAlways( object != nullptr ) )
         {
@@ -81,49 +113,100 @@ namespace
             return false;
         }
 
-        if ( auto * state = object_map.Find( id ) )
-        {
-            if ( *state == EMSState::Active )
-            {
-                return true;
-            }
+        const auto index = table.FindIndex( id );
 
+        if ( index == INDEX_NONE )
+        {
             return false;
         }
 
-        object_map.Add( id, EMSState::Active );
-
+        table.SetState( index, was_cancelled ? EMSState::Cancelled : EMSState::Complete );
+        changed_ids.Add( id );
         return true;
     }
 
-    template < typename _ObjectType_ >
-    bool SetComplete( _ObjectType_ object, TMap< FGuid, EMSState > & object_map, const bool was_cancelled )
+    constexpr uint8 CompressedFlag = 1 << 0;
+
+    // Upper bound of the compression ratio of zlib, used to reject corrupted sizes before allocating
+    constexpr int64 MaxCompressionRatio = 1032;
+
+    // Writes the state of each changed entry, or reads the changes without applying them
+    void SerializeTableChanges( FArchive & archive, const FMSMissionStateTable & table, const TSet< FGuid > & changed_ids, TArray< TPair< FGuid, uint8 > > & changes )
     {
-        if ( !ensureAlways( object != nullptr ) )
+        uint32 change_count = changed_ids.Num();
+        archive.SerializeIntPacked( change_count );
+
+        if ( archive.IsSaving() )
         {
-            return false;
-        }
+            for ( auto id : changed_ids )
+            {
+                // 0 is written for the entries which do not have a state anymore
+                const auto state = table.GetState( table.FindIndex( id ) );
+                uint8 packed_state = state.IsSet() ? static_cast< uint8 >( state.GetValue() ) + 1 : 0;
 
-        const auto id = GetGuid( object );
+                archive << id;
+                archive << packed_state;
+            }
 
-        if ( !ensureAlways( id.IsValid() ) )
+            return;
+        }
+
+        if ( archive.IsError() || ( archive.TotalSize() >= 0 && change_count > static_cast< uint64 >( archive.TotalSize() ) / sizeof( FGuid ) ) )
         {
-            return false;
+            archive.SetError();
+            return;
         }
 
-        if ( auto * found_id = object_map.Find( id ) )
+        changes.Reserve( change_count );
+
+        for ( auto index = 0u; index < change_count; ++index )
         {
-            *found_id = was_cancelled ? EMSState::Cancelled : EMSState::Complete;
-            return true;
+            auto & change = changes.Emplace_GetRef();
+            archive << change.Key;
+            archive << change.Value;
+
+            if ( change.Value > static_cast< uint8 >( EMSState::Complete ) + 1 )
+            {
+                archive.SetError();
+                return;
+            }
         }
+    }
 
-        return false;
+    void MigrateStates( const TMap< FGuid, EMSState > & states, FMSMissionStateTable & table )
+    {
+        table.Reset();
+
+        for ( const auto & [ id, state ] : states )
+        {
+            table.SetState( table.FindOrAddIndex( id ), state );
+        }
     }
 }
 
 bool FMSMissionHistory::HasData() const
 {
-    return !MissionStates.IsEmpty() || !ObjectiveStates.IsEmpty();
+    return MissionStates.GetStateCount() > 0 || ObjectiveStates.GetStateCount() > 0;
+}
+
+bool FMSMissionHistory::IsMissionActive( const FGuid & mission_id ) const
+{
+    return MissionStates.HasState( MissionStates.FindIndex( mission_id ), EMSState::Active );
+}
+
+bool FMSMissionHistory::IsMissionCancelled( const FGuid & mission_id ) const
+{
+    return MissionStates.HasState( MissionStates.FindIndex( mission_id ), EMSState::Cancelled );
+}
+
+bool FMSMissionHistory::IsMissionComplete( const FGuid & mission_id ) const
+{
+    return MissionStates.HasState( MissionStates.FindIndex( mission_id ), EMSState::Complete );
+}
+
+bool FMSMissionHistory::IsMissionFinished( const FGuid & mission_id ) const
+{
+    return MissionStates.IsFinished( MissionStates.FindIndex( mission_id ) );
 }
 
 bool FMSMissionHistory::IsMissionActive( UMSMissionData * mission_data ) const
@@ -143,36 +226,81 @@ bool FMSMissionHistory::IsMissionComplete( UMSMissionData * mission_data ) const
 
 bool FMSMissionHistory::IsMissionFinished( UMSMissionData * mission_data ) const
 {
-    const auto state = GetState( mission_data, MissionStates ).Get( EMSState::Active );
-    return state > EMSState::Active;
+    return MissionStates.IsFinished( FindIndex( mission_data, MissionStates ) );
 }
 
 bool FMSMissionHistory::AddActiveMission( UMSMissionData * mission_data )
 {
-    if ( !TryAddToMap( mission_data, MissionStates ) )
+    if ( !TryAddToTable( mission_data, MissionStates, ChangedMissionIds ) )
     {
         return false;
     }
 
-    check( !ActiveMissionsData.Contains( mission_data ) );
-    ActiveMissionsData.Add( mission_data );
+    check( !ActiveMissionIds.Contains( mission_data->GetGuid() ) );
+    ActiveMissionIds.Add( mission_data->GetGuid() );
 
     return true;
 }
 
 bool FMSMissionHistory::SetMissionComplete( UMSMissionData * mission_data, bool was_cancelled )
 {
-    if ( !SetComplete( mission_data, MissionStates, was_cancelled ) )
+    if ( !SetComplete( mission_data, MissionStates, ChangedMissionIds, was_cancelled ) )
     {
         return false;
     }
 
-    check( ActiveMissionsData.Contains( mission_data ) );
-    ActiveMissionsData.Remove( mission_data );
+    check( ActiveMissionIds.Contains( mission_data->GetGuid() ) );
+    ActiveMissionIds.Remove( mission_data->GetGuid() );
 
     return true;
 }
 
+int32 FMSMissionHistory::FindMissionIndex( UMSMissionData * mission_data ) const
+{
+    return FindIndex( mission_data, MissionStates );
+}
+
+void FMSMissionHistory::SetMissionState( const FGuid & mission_id, const TOptional< EMSState > state )
+{
+    const auto index = MissionStates.FindOrAddIndex( mission_id );
+
+    ActiveMissionIds.Remove( mission_id );
+    ChangedMissionIds.Add( mission_id );
+
+    if ( !state.IsSet() )
+    {
+        MissionStates.ClearState( index );
+        return;
+    }
+
+    MissionStates.SetState( index, state.GetValue() );
+
+    if ( state.GetValue() == EMSState::Active )
+    {
+        ActiveMissionIds.Add( mission_id );
+    }
+}
+
+bool FMSMissionHistory::IsObjectiveActive( const FGuid & objective_id ) const
+{
+    return ObjectiveStates.HasState( ObjectiveStates.FindIndex( objective_id ), EMSState::Active );
+}
+
+bool FMSMissionHistory::IsObjectiveCancelled( const FGuid & objective_id ) const
+{
+    return ObjectiveStates.HasState( ObjectiveStates.FindIndex( objective_id ), EMSState::Cancelled );
+}
+
+bool FMSMissionHistory::IsObjectiveComplete( const FGuid & objective_id ) const
+{
+    return ObjectiveStates.HasState( ObjectiveStates.FindIndex( objective_id ), EMSState::Complete );
+}
+
+bool FMSMissionHistory::IsObjectiveFinished( const FGuid & objective_id ) const
+{
+    return ObjectiveStates.IsFinished( ObjectiveStates.FindIndex( objective_id ) );
+}
+
 bool FMSMissionHistory::IsObjectiveActive( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const
 {
     return DoesObjectiveHasState( mission_objective_class, EMSState::Active );
@@ -190,40 +318,426 @@ bool FMSMissionHistory::IsObjectiveComplete( const TSubclassOf< UMSMissionObject
 
 bool FMSMissionHistory::IsObjectiveFinished( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const
 {
-    const auto state = GetState( mission_objective_class, ObjectiveStates ).Get( EMSState::Active );
-    return state > EMSState::Active;
+    return ObjectiveStates.IsFinished( FindIndex( mission_objective_class, ObjectiveStates ) );
 }
 
 bool FMSMissionHistory::AddActiveObjective( const TSubclassOf< UMSMissionObjective > & mission_objective_class )
 {
-    return TryAddToMap( mission_objective_class, ObjectiveStates );
+    return TryAddToTable( mission_objective_class, ObjectiveStates, ChangedObjectiveIds );
 }
 
 bool FMSMissionHistory::SetObjectiveComplete( const TSubclassOf< UMSMissionObjective > & mission_objective_class, bool was_cancelled )
 {
-    return SetComplete( mission_objective_class, ObjectiveStates, was_cancelled );
+    return SetComplete( mission_objective_class, ObjectiveStates, ChangedObjectiveIds, was_cancelled );
+}
+
+int32 FMSMissionHistory::FindObjectiveIndex( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const
+{
+    return FindIndex( mission_objective_class, ObjectiveStates );
+}
+
+void FMSMissionHistory::SetObjectiveState( const FGuid & objective_id, const TOptional< EMSState > state )
+{
+    const auto index = ObjectiveStates.FindOrAddIndex( objective_id );
+
+    ChangedObjectiveIds.Add( objective_id );
+
+    if ( state.IsSet() )
+    {
+        ObjectiveStates.SetState( index, state.GetValue() );
+    }
+    else
+    {
+        ObjectiveStates.ClearState( index );
+    }
+}
+
+bool FMSMissionHistory::IsObjectiveFinished( const int32 objective_index ) const
+{
+    return ObjectiveStates.IsFinished( objective_index );
+}
+
+void FMSMissionHistory::BindToGraph( const UMSMissionGraph & mission_graph )
+{
+    // The states loaded with the indices of another graph can not be given an ID
+    if ( GraphId.IsValid() && GraphId != mission_graph.GetGraphId() )
+    {
+        if ( MissionStates.GetBoundCount() > 0 || ObjectiveStates.GetBoundCount() > 0 )
+        {
+            UE_LOG( LogMissionSystem, Error, TEXT( "The mission history was saved with the indices of another mission graph. Its missions and objectives are dropped" ) );
+        }
+
+        MissionStates.ClearUnboundStates();
+        ObjectiveStates.ClearUnboundStates();
+        UnboundActiveMissionIndices.Reset();
+    }
+
+    MissionStates.Bind( mission_graph.GetMissionIds(), [ &mission_graph ]( const FGuid & id ) {
+        return mission_graph.FindMissionIndex( id );
+    } );
+    ObjectiveStates.Bind( mission_graph.GetObjectiveIds(), [ &mission_graph ]( const FGuid & id ) {
+        return mission_graph.FindObjectiveIndex( id );
+    } );
+
+    for ( const auto mission_index : UnboundActiveMissionIndices )
+    {
+        if ( MissionStates.HasId( mission_index ) && MissionStates.HasState( mission_index, EMSState::Active ) )
+        {
+            ActiveMissionIds.AddUnique( MissionStates.GetId( mission_index ) );
+        }
+    }
+
+    UnboundActiveMissionIndices.Reset();
+    GraphId = mission_graph.GetGraphId();
+    bIsBoundToGraph = true;
 }
 
 void FMSMissionHistory::Clear()
 {
-    ActiveMissionsData.Reset();
+    ActiveMissionIds.Reset();
+    UnboundActiveMissionIndices.Reset();
     MissionStates.Reset();
     ObjectiveStates.Reset();
+
+    if ( !bIsBoundToGraph )
+    {
+        GraphId.Invalidate();
+    }
+
+    // The cleared entries can not be expressed as changes, so the next save must be a full one
+    ChangedMissionIds.Reset();
+    ChangedObjectiveIds.Reset();
+    bNeedsSnapshot = true;
+}
+
+void FMSMissionHistory::Checkpoint()
+{
+    ChangedMissionIds.Reset();
+    ChangedObjectiveIds.Reset();
+    bNeedsSnapshot = false;
+}
+
+int32 FMSMissionHistory::SerializeChanges( FArchive & archive )
+{
+    auto version = static_cast< int32 >( FMSMissionHistoryVersion::LatestVersion );
+    archive << version;
+
+    if ( archive.IsLoading() && version > FMSMissionHistoryVersion::LatestVersion )
+    {
+        UE_LOG( LogMissionSystem, Error, TEXT( "Can not load mission history changes saved with a newer version (%d)" ), version );
+        archive.SetError();
+        return 0;
+    }
+
+    TArray< TPair< FGuid, uint8 > > mission_changes;
+    TArray< TPair< FGuid, uint8 > > objective_changes;
+
+    SerializeTableChanges( archive, MissionStates, ChangedMissionIds, mission_changes );
+    SerializeTableChanges( archive, ObjectiveStates, ChangedObjectiveIds, objective_changes );
+
+    if ( archive.IsSaving() )
+    {
+        return ChangedMissionIds.Num() + ChangedObjectiveIds.Num();
+    }
+
+    // :NOTE: Changes are only applied once they have all been read, so a truncated journal does not leave the history half updated
+    if ( archive.IsError() )
+    {
+        return 0;
+    }
+
+    const auto to_state = []( const uint8 packed_state ) {
+        return packed_state != 0 ? TOptional< EMSState >( static_cast< EMSState >( packed_state - 1 ) ) : TOptional< EMSState >();
+    };
+
+    for ( const auto & [ mission_id, packed_state ] : mission_changes )
+    {
+        SetMissionState( mission_id, to_state( packed_state ) );
+    }
+
+    for ( const auto & [ objective_id, packed_state ] : objective_changes )
+    {
+        SetObjectiveState( objective_id, to_state( packed_state ) );
+    }
+
+    return mission_changes.Num() + objective_changes.Num();
 }
 
 bool FMSMissionHistory::DoesMissionHasState( UMSMissionData * mission_data, EMSState state ) const
 {
-    return DoesHaveState( mission_data, MissionStates, state );
+    return MissionStates.HasState( FindIndex( mission_data, MissionStates ), state );
 }
 
 bool FMSMissionHistory::DoesObjectiveHasState( const TSubclassOf< UMSMissionObjective > & mission_objective_class, EMSState state ) const
 {
-    return DoesHaveState( mission_objective_class, ObjectiveStates, state );
+    return ObjectiveStates.HasState( FindIndex( mission_objective_class, ObjectiveStates ), state );
+}
+
+void FMSMissionHistory::SerializeInitialVersion( FArchive & archive, const int32 active_missions_count )
+{
+    check( archive.IsLoading() );
+
+    if ( active_missions_count < 0 )
+    {
+        archive.SetError();
+        return;
+    }
+
+    SerializeActiveMissionsData( archive, active_missions_count );
+
+    TMap< FGuid, EMSState > mission_states;
+    TMap< FGuid, EMSState > objective_states;
+
+    archive << mission_states;
+    archive << objective_states;
+
+    MigrateStates( mission_states, MissionStates );
+    MigrateStates( objective_states, ObjectiveStates );
+}
+
+void FMSMissionHistory::SerializeActiveMissionsData( FArchive & archive, const int32 active_missions_count )
+{
+    check( archive.IsLoading() );
+
+    ActiveMissionIds.Reset( active_missions_count );
+
+    // Older histories reference the mission data, which forces them to be loaded with the history
+    for ( auto index = 0; index < active_missions_count; ++index )
+    {
+        UMSMissionData * mission_data = nullptr;
+        archive << mission_data;
+
+        if ( mission_data != nullptr )
+        {
+            ActiveMissionIds.Add( mission_data->GetGuid() );
+        }
+    }
+}
+
+void FMSMissionHistory::SerializeCompact( FArchive & archive, const int32 version )
+{
+    uint8 flags = archive.IsSaving() && CVarCompressMissionHistory.GetValueOnAnyThread() ? CompressedFlag : 0;
+    archive << flags;
+
+    if ( ( flags & CompressedFlag ) == 0 )
+    {
+        SerializeCompactBody( archive, version );
+        return;
+    }
+
+    if ( archive.IsSaving() )
+    {
+        TArray< uint8 > body;
+        FMemoryWriter writer( body );
+        SerializeCompactBody( writer, version );
+
+        auto uncompressed_size = body.Num();
+        auto compressed_size = FCompression::CompressMemoryBound( NAME_Zlib, uncompressed_size );
+
+        TArray< uint8 > compressed_body;
+        compressed_body.SetNumUninitialized( compressed_size );
+
+        if ( !FCompression::CompressMemory( NAME_Zlib, compressed_body.GetData(), compressed_size, body.GetData(), uncompressed_size ) )
+        {
+            UE_LOG( LogMissionSystem, Error, TEXT( "Failed to compress the mission history" ) );
+            archive.SetError();
+            return;
+        }
+
+        compressed_body.SetNum( compressed_size );
+
+        archive << uncompressed_size;
+        archive << compressed_body;
+        return;
+    }
+
+    int32 uncompressed_size = 0;
+    TArray< uint8 > compressed_body;
+
+    archive << uncompressed_size;
+    archive << compressed_body;
+
+    if ( archive.IsError() || uncompressed_size < 0 || uncompressed_size > compressed_body.Num() * MaxCompressionRatio )
+    {
+        archive.SetError();
+        return;
+    }
+
+    TArray< uint8 > body;
+    body.SetNumUninitialized( uncompressed_size );
+
+    if ( !FCompression::UncompressMemory( NAME_Zlib, body.GetData(), uncompressed_size, compressed_body.GetData(), compressed_body.Num() ) )
+    {
+        UE_LOG( LogMissionSystem, Error, TEXT( "Failed to uncompress the mission history" ) );
+        archive.SetError();
+        return;
+    }
+
+    FMemoryReader reader( body );
+    SerializeCompactBody( reader, version );
+
+    if ( reader.IsError() )
+    {
+        archive.SetError();
+    }
+}
+
+void FMSMissionHistory::SerializeCompactBody( FArchive & archive, const int32 version )
+{
+    TArray< int32 > mission_indices;
+    TArray< int32 > objective_indices;
+
+    if ( version >= FMSMissionHistoryVersion::GraphIndices )
+    {
+        auto graph_id = GraphId;
+        archive << graph_id;
+
+        if ( archive.IsLoading() )
+        {
+            if ( bIsBoundToGraph && graph_id.IsValid() && graph_id != GraphId )
+            {
+                UE_LOG( LogMissionSystem, Error, TEXT( "Can not load a mission history saved with the indices of another mission graph" ) );
+                archive.SetError();
+                return;
+            }
+
+            if ( !bIsBoundToGraph )
+            {
+                GraphId = graph_id;
+            }
+        }
+
+        MissionStates.SerializeIndexed( archive, mission_indices );
+        ObjectiveStates.SerializeIndexed( archive, objective_indices );
+    }
+    else
+    {
+        MissionStates.SerializeCompact( archive, mission_indices );
+        ObjectiveStates.SerializeCompact( archive, objective_indices );
+    }
+
+    // Active missions are referenced by their index in the mission table, instead of repeating their GUID
+    uint32 active_missions_count = ActiveMissionIds.Num() + UnboundActiveMissionIndices.Num();
+    archive.SerializeIntPacked( active_missions_count );
+
+    if ( archive.IsSaving() )
+    {
+        for ( const auto & mission_id : ActiveMissionIds )
+        {
+            const auto mission_index = MissionStates.FindIndex( mission_id );
+            check( mission_index != INDEX_NONE );
+
+            auto compact_index = static_cast< uint32 >( mission_indices[ mission_index ] );
+            archive.SerializeIntPacked( compact_index );
+        }
+
+        for ( const auto mission_index : UnboundActiveMissionIndices )
+        {
+            auto compact_index = static_cast< uint32 >( mission_indices[ mission_index ] );
+            archive.SerializeIntPacked( compact_index );
+        }
+
+        return;
+    }
+
+    ActiveMissionIds.Reset();
+    UnboundActiveMissionIndices.Reset();
+
+    if ( archive.IsError() || active_missions_count > static_cast< uint32 >( mission_indices.Num() ) )
+    {
+        archive.SetError();
+        return;
+    }
+
+    ActiveMissionIds.Reserve( active_missions_count );
+
+    for ( auto index = 0u; index < active_missions_count; ++index )
+    {
+        uint32 compact_index = 0;
+        archive.SerializeIntPacked( compact_index );
+
+        if ( archive.IsError() || !mission_indices.IsValidIndex( compact_index ) )
+        {
+            archive.SetError();
+            return;
+        }
+
+        const auto mission_index = mission_indices[ compact_index ];
+
+        // Until the history is bound to the graph it was saved with, the missions of the graph are only known by their index
+        if ( MissionStates.HasId( mission_index ) )
+        {
+            ActiveMissionIds.Add( MissionStates.GetId( mission_index ) );
+        }
+        else
+        {
+            UnboundActiveMissionIndices.Add( mission_index );
+        }
+    }
 }
 
 FArchive & operator<<( FArchive & archive, FMSMissionHistory & mission_history )
 {
-    archive << mission_history.ActiveMissionsData;
+    // :NOTE: The version is also written in the stream, as the histories saved outside of packages do not store the custom versions
+    archive.UsingCustomVersion( FMSMissionHistoryVersion::GUID );
+
+    auto version = static_cast< int32 >( FMSMissionHistoryVersion::LatestVersion );
+
+    if ( archive.IsLoading() )
+    {
+        // The loaded tables stay bound to the graph. The graph of a history which is not bound is read with the history
+        mission_history.UnboundActiveMissionIndices.Reset();
+
+        if ( !mission_history.bIsBoundToGraph )
+        {
+            mission_history.GraphId.Invalidate();
+        }
+
+        // The loaded history is the new snapshot the next changes are relative to
+        mission_history.Checkpoint();
+
+        int32 header;
+        archive << header;
+
+        if ( header != FMSMissionHistoryVersion::HeaderTag )
+        {
+            mission_history.SerializeInitialVersion( archive, header );
+            return archive;
+        }
+
+        archive << version;
+
+        if ( version > FMSMissionHistoryVersion::LatestVersion )
+        {
+            UE_LOG( LogMissionSystem, Error, TEXT( "Can not load a mission history saved with a newer version (%d)" ), version );
+            archive.SetError();
+            return archive;
+        }
+    }
+    else
+    {
+        auto header = FMSMissionHistoryVersion::HeaderTag;
+        archive << header;
+        archive << version;
+    }
+
+    if ( version >= FMSMissionHistoryVersion::CompactEncoding )
+    {
+        mission_history.SerializeCompact( archive, version );
+        return archive;
+    }
+
+    if ( version < FMSMissionHistoryVersion::ActiveMissionIds )
+    {
+        int32 active_missions_count;
+        archive << active_missions_count;
+        mission_history.SerializeActiveMissionsData( archive, active_missions_count );
+    }
+    else
+    {
+        archive << mission_history.ActiveMissionIds;
+    }
+
     archive << mission_history.MissionStates;
     archive << mission_history.ObjectiveStates;
 
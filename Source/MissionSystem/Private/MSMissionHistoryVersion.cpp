@@ -0,0 +1,7 @@
+#include "MSMissionHistoryVersion.h"
+
+#include <Serialization/CustomVersion.h>
+
+const FGuid FMSMissionHistoryVersion::GUID( 0x4D534849, 0x8A3C4E21, 0x9B7D52F6, 0x1E0C6A93 );
+
+static FCustomVersionRegistration GRegisterMissionHistoryVersion( FMSMissionHistoryVersion::GUID, FMSMissionHistoryVersion::LatestVersion, TEXT( "MissionHistory" ) );
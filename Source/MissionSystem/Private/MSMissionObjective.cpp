@@ -6,21 +6,62 @@
 UMSMissionObjective::UMSMissionObjective() :
     bExecuteEndActionsWhenCancelled( false ),
     bIsComplete( false ),
-    bIsCancelled( false )
+    bIsCancelled( false ),
+    bHasEnded( false )
 {
 }
 
-void UMSMissionObjective::Execute()
+void UMSMissionObjective::Execute( const bool hold_barrier_actions )
 {
+    // The actions are instanced in each objective, so the executors run them without copying them
     StartActionsExecutor.Initialize( this, StartActions, [ this ]() {
         K2_Execute();
     } );
 
     EndActionsExecutor.Initialize( this, EndActions, [ this ]() {
+        bHasEnded = true;
         OnObjectiveCompleteEvent.Broadcast( this, bIsCancelled );
     } );
 
-    StartActionsExecutor.Execute();
+    StartActionsExecutor.Execute( hold_barrier_actions );
+}
+
+void UMSMissionObjective::ExecuteBarrierActions()
+{
+    if ( !bIsComplete && !bIsCancelled )
+    {
+        StartActionsExecutor.ExecuteBarrierActions();
+    }
+}
+
+void UMSMissionObjective::ReleaseActions()
+{
+    StartActionsExecutor.Release();
+    EndActionsExecutor.Release();
+}
+
+void UMSMissionObjective::ResetObjective()
+{
+    StartActionsExecutor.Reset();
+    EndActionsExecutor.Reset();
+    OnObjectiveCompleteEvent.Clear();
+    OnObjectiveEndActionsStartedEvent.Clear();
+
+    for ( auto * action : StartActions )
+    {
+        action->ResetAction();
+    }
+
+    for ( auto * action : EndActions )
+    {
+        action->ResetAction();
+    }
+
+    bIsComplete = false;
+    bIsCancelled = false;
+    bHasEnded = false;
+
+    K2_OnReset();
 }
 
 void UMSMissionObjective::PostLoad()
@@ -50,6 +91,7 @@ void UMSMissionObjective::CompleteObjective()
     {
         bIsComplete = true;
         K2_OnObjectiveEnded( false );
+        OnObjectiveEndActionsStartedEvent.Broadcast( this );
         EndActionsExecutor.Execute();
     }
 }
@@ -68,6 +110,7 @@ void UMSMissionObjective::CancelObjective()
         }
         else
         {
+            bHasEnded = true;
             OnObjectiveCompleteEvent.Broadcast( this, bIsCancelled );
         }
     }
@@ -123,3 +166,7 @@ void UMSMissionObjective::K2_Execute_Implementation()
 void UMSMissionObjective::K2_OnObjectiveEnded_Implementation( bool /*was_cancelled*/ )
 {
 }
+
+void UMSMissionObjective::K2_OnReset_Implementation()
+{
+}
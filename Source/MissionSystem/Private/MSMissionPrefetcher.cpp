@@ -0,0 +1,256 @@
+#include "MSMissionPrefetcher.h"
+
+#include "MSLog.h"
+#include "MSMissionData.h"
+#include "MSMissionGraph.h"
+
+namespace
+{
+    void StopHandle( const TSharedPtr< FStreamableHandle > & handle )
+    {
+        if ( !handle.IsValid() )
+        {
+            return;
+        }
+
+        // :NOTE: Cancel the requests still loading, so their callbacks are not called
+        if ( handle->IsLoadingInProgress() )
+        {
+            handle->CancelHandle();
+        }
+        else
+        {
+            handle->ReleaseHandle();
+        }
+    }
+
+    // Adds the path of the mission data and of its objectives to paths. When only_unloaded is set, the assets already in memory are skipped
+    void GetMissionPaths( const UMSMissionGraph & mission_graph, const int32 mission_index, const bool only_unloaded, TArray< FSoftObjectPath > & paths )
+    {
+        const auto & mission_data = mission_graph.GetMission( mission_index ).MissionData;
+
+        if ( !only_unloaded || mission_data.Get() == nullptr )
+        {
+            paths.Add( mission_data.ToSoftObjectPath() );
+        }
+
+        for ( const auto objective_index : mission_graph.GetMissionObjectives( mission_index ) )
+        {
+            const auto & objective = mission_graph.GetObjective( objective_index );
+
+            if ( !only_unloaded || objective.Get() == nullptr )
+            {
+                paths.Add( objective.ToSoftObjectPath() );
+            }
+        }
+    }
+}
+
+FMSMissionPrefetcher::~FMSMissionPrefetcher()
+{
+    Reset();
+}
+
+int32 FMSMissionPrefetcher::GetPrefetchedMissionCount() const
+{
+    TSet< FSoftObjectPath > mission_paths;
+    Handles.GetKeys( mission_paths );
+
+    return mission_paths.Num();
+}
+
+int32 FMSMissionPrefetcher::GetLoadingRequestCount() const
+{
+    auto count = 0;
+
+    for ( const auto & [ mission_path, handle ] : Handles )
+    {
+        if ( handle.IsValid() && handle->IsLoadingInProgress() )
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+void FMSMissionPrefetcher::PrefetchNextMissions( const UMSMissionGraph & mission_graph, const int32 mission_index, const int32 depth )
+{
+    TArray< int32 > missions_to_visit;
+    TArray< int32 > next_missions_to_visit;
+    TSet< int32 > visited_missions;
+
+    missions_to_visit.Add( mission_index );
+    visited_missions.Add( mission_index );
+
+    // Breadth first, one level of the lookahead at a time
+    for ( auto level = 0; level < depth && missions_to_visit.Num() > 0; ++level )
+    {
+        for ( const auto visited_mission_index : missions_to_visit )
+        {
+            for ( const auto next_mission_index : mission_graph.GetNextMissions( visited_mission_index ) )
+            {
+                if ( visited_missions.Contains( next_mission_index ) )
+                {
+                    continue;
+                }
+
+                visited_missions.Add( next_mission_index );
+                next_missions_to_visit.Add( next_mission_index );
+
+                // Disabled missions are skipped without loading their data, but their next missions are still prefetched
+                if ( !mission_graph.GetMission( next_mission_index ).bEnabled )
+                {
+                    continue;
+                }
+
+                const auto mission_path = mission_graph.GetMission( next_mission_index ).MissionData.ToSoftObjectPath();
+
+                if ( Handles.Contains( mission_path ) )
+                {
+                    continue;
+                }
+
+                // :NOTE: Also request the assets already loaded, so the request keeps them alive until the mission starts
+                TArray< FSoftObjectPath > paths;
+                GetMissionPaths( mission_graph, next_mission_index, false, paths );
+
+                Request( mission_path, MoveTemp( paths ), {} );
+            }
+        }
+
+        Swap( missions_to_visit, next_missions_to_visit );
+        next_missions_to_visit.Reset();
+    }
+}
+
+void FMSMissionPrefetcher::PrefetchNextMissions( const UMSMissionData & mission_data, const int32 depth )
+{
+    if ( depth <= 0 )
+    {
+        return;
+    }
+
+    for ( const auto & next_mission : mission_data.NextMissions )
+    {
+        if ( next_mission.IsNull() || Handles.Contains( next_mission.ToSoftObjectPath() ) )
+        {
+            continue;
+        }
+
+        LoadMission( next_mission, [ this, depth ]( UMSMissionData * next_mission_data ) {
+            PrefetchNextMissions( *next_mission_data, depth - 1 );
+        } );
+    }
+}
+
+void FMSMissionPrefetcher::LoadMission( const UMSMissionGraph & mission_graph, const int32 mission_index, FOnMissionLoaded && on_loaded )
+{
+    const auto & mission_data = mission_graph.GetMission( mission_index ).MissionData;
+
+    TArray< FSoftObjectPath > paths;
+    GetMissionPaths( mission_graph, mission_index, true, paths );
+
+    if ( paths.Num() == 0 )
+    {
+        on_loaded( mission_data.Get() );
+        return;
+    }
+
+    UE_LOG( LogMissionSystem, Verbose, TEXT( "%s was not prefetched and is loaded before it starts" ), *mission_data.ToString() );
+
+    Request( mission_data.ToSoftObjectPath(), MoveTemp( paths ), [ mission_data, callback = MoveTemp( on_loaded ) ]() {
+        if ( auto * loaded_mission_data = mission_data.Get() )
+        {
+            callback( loaded_mission_data );
+        }
+    } );
+}
+
+void FMSMissionPrefetcher::LoadMission( const TSoftObjectPtr< UMSMissionData > & mission_data, FOnMissionLoaded && on_loaded )
+{
+    if ( auto * loaded_mission_data = mission_data.Get() )
+    {
+        LoadObjectives( *loaded_mission_data, MoveTemp( on_loaded ) );
+        return;
+    }
+
+    if ( mission_data.IsNull() )
+    {
+        return;
+    }
+
+    const auto mission_path = mission_data.ToSoftObjectPath();
+
+    Request( mission_path, { mission_path }, [ this, mission_data, callback = MoveTemp( on_loaded ) ]() mutable {
+        if ( auto * loaded_mission_data = mission_data.Get() )
+        {
+            LoadObjectives( *loaded_mission_data, MoveTemp( callback ) );
+        }
+    } );
+}
+
+void FMSMissionPrefetcher::Release( const FSoftObjectPath & mission_path )
+{
+    TArray< TSharedPtr< FStreamableHandle > > handles;
+    Handles.MultiFind( mission_path, handles );
+    Handles.Remove( mission_path );
+
+    for ( const auto & handle : handles )
+    {
+        StopHandle( handle );
+    }
+}
+
+void FMSMissionPrefetcher::Reset()
+{
+    // :NOTE: Move the handles out, as cancelling a request must not modify the map being iterated
+    const auto handles = MoveTemp( Handles );
+    Handles.Reset();
+
+    for ( const auto & [ mission_path, handle ] : handles )
+    {
+        StopHandle( handle );
+    }
+}
+
+void FMSMissionPrefetcher::LoadObjectives( UMSMissionData & mission_data, FOnMissionLoaded && on_loaded )
+{
+    TArray< FSoftObjectPath > paths;
+
+    for ( const auto & objective_data : mission_data.Objectives )
+    {
+        if ( objective_data.bEnabled && !objective_data.Objective.IsNull() && objective_data.Objective.Get() == nullptr )
+        {
+            paths.Add( objective_data.Objective.ToSoftObjectPath() );
+        }
+    }
+
+    if ( paths.Num() == 0 )
+    {
+        on_loaded( &mission_data );
+        return;
+    }
+
+    Request( FSoftObjectPath( &mission_data ), MoveTemp( paths ), [ weak_mission_data = TWeakObjectPtr< UMSMissionData >( &mission_data ), callback = MoveTemp( on_loaded ) ]() {
+        if ( auto * loaded_mission_data = weak_mission_data.Get() )
+        {
+            callback( loaded_mission_data );
+        }
+    } );
+}
+
+void FMSMissionPrefetcher::Request( const FSoftObjectPath & mission_path, TArray< FSoftObjectPath > && paths, TFunction< void() > && on_complete )
+{
+    auto handle = StreamableManager.RequestAsyncLoad( MoveTemp( paths ), [ callback = MoveTemp( on_complete ) ]() {
+        if ( callback )
+        {
+            callback();
+        }
+    } );
+
+    if ( handle.IsValid() )
+    {
+        Handles.Add( mission_path, MoveTemp( handle ) );
+    }
+}
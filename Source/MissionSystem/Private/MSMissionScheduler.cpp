@@ -0,0 +1,181 @@
+#include "MSMissionScheduler.h"
+
+#include "MSMission.h"
+#include "MSMissionAction.h"
+#include "MSMissionData.h"
+
+#include <Algo/Find.h>
+
+FMSMissionTransition::FMSMissionTransition() :
+    Type( EMSMissionTransitionType::StartMission ),
+    Priority( EMSMissionTransitionPriority::Normal ),
+    MissionData( nullptr ),
+    Mission( nullptr ),
+    Action( nullptr ),
+    MissionIndex( INDEX_NONE ),
+    ActionGeneration( 0 ),
+    ScheduleTime( 0.0 )
+{
+}
+
+FMSMissionTransition FMSMissionTransition::MakeStartMission( UMSMissionData * mission_data )
+{
+    FMSMissionTransition transition;
+    transition.Type = EMSMissionTransitionType::StartMission;
+    transition.MissionData = mission_data;
+
+    if ( mission_data != nullptr )
+    {
+        transition.Priority = mission_data->Priority;
+    }
+
+    return transition;
+}
+
+FMSMissionTransition FMSMissionTransition::MakeResumeMission( UMSMissionData * mission_data )
+{
+    FMSMissionTransition transition;
+    transition.Type = EMSMissionTransitionType::ResumeMission;
+    transition.MissionData = mission_data;
+
+    if ( mission_data != nullptr )
+    {
+        transition.Priority = mission_data->Priority;
+    }
+
+    return transition;
+}
+
+FMSMissionTransition FMSMissionTransition::MakeStartNextMissions( UMSMissionData * mission_data )
+{
+    FMSMissionTransition transition;
+    transition.Type = EMSMissionTransitionType::StartNextMissions;
+    transition.MissionData = mission_data;
+    return transition;
+}
+
+FMSMissionTransition FMSMissionTransition::MakeStartNextMissions( const int32 mission_index )
+{
+    FMSMissionTransition transition;
+    transition.Type = EMSMissionTransitionType::StartNextMissions;
+    transition.MissionIndex = mission_index;
+    return transition;
+}
+
+FMSMissionTransition FMSMissionTransition::MakeExecuteNextObjective( UMSMission * mission )
+{
+    // Missions which already run go first, so they are not delayed by the missions which start
+    FMSMissionTransition transition;
+    transition.Type = EMSMissionTransitionType::ExecuteNextObjective;
+    transition.Priority = EMSMissionTransitionPriority::High;
+    transition.Mission = mission;
+    return transition;
+}
+
+FMSMissionTransition FMSMissionTransition::MakeExecuteAction( UMSMissionAction * action )
+{
+    FMSMissionTransition transition;
+    transition.Type = EMSMissionTransitionType::ExecuteAction;
+    transition.Priority = EMSMissionTransitionPriority::High;
+    transition.Action = action;
+    transition.ActionGeneration = action->GetGeneration();
+    return transition;
+}
+
+FMSMissionTransitionQueue::FMSMissionTransitionQueue() :
+    FirstIndex( 0 )
+{
+}
+
+FMSMissionScheduler::FMSMissionScheduler() :
+    PendingTransitionCount( 0 ),
+    MaxPendingTransitionCount( 0 ),
+    ProcessedTransitionCount( 0 ),
+    LastDrainMaxLag( 0.0 ),
+    LastDrainProcessedTransitionCount( 0 ),
+    bIsDraining( false )
+{
+}
+
+double FMSMissionScheduler::GetQueueLag() const
+{
+    auto oldest_schedule_time = TNumericLimits< double >::Max();
+
+    for ( const auto & queue : Queues )
+    {
+        if ( !queue.IsEmpty() )
+        {
+            oldest_schedule_time = FMath::Min( oldest_schedule_time, queue.Transitions[ queue.FirstIndex ].ScheduleTime );
+        }
+    }
+
+    return PendingTransitionCount > 0 ? FPlatformTime::Seconds() - oldest_schedule_time : 0.0;
+}
+
+void FMSMissionScheduler::Enqueue( FMSMissionTransition && transition )
+{
+    transition.ScheduleTime = FPlatformTime::Seconds();
+
+    Queues[ static_cast< uint8 >( transition.Priority ) ].Transitions.Emplace( MoveTemp( transition ) );
+
+    ++PendingTransitionCount;
+    MaxPendingTransitionCount = FMath::Max( MaxPendingTransitionCount, PendingTransitionCount );
+}
+
+void FMSMissionScheduler::Drain( const TFunctionRef< void( const FMSMissionTransition & ) > processor, const double budget_seconds )
+{
+    if ( bIsDraining || PendingTransitionCount == 0 )
+    {
+        return;
+    }
+
+    TGuardValue< bool > draining_guard( bIsDraining, true );
+
+    const auto start_time = FPlatformTime::Seconds();
+    LastDrainMaxLag = 0.0;
+    LastDrainProcessedTransitionCount = 0;
+
+    while ( PendingTransitionCount > 0 )
+    {
+        // Start again from the highest priority, as the previous transition can have scheduled new ones
+        auto * queue = Algo::FindByPredicate( Queues, []( const FMSMissionTransitionQueue & priority_queue ) {
+            return !priority_queue.IsEmpty();
+        } );
+
+        check( queue != nullptr );
+
+        // :NOTE: Copy the transition, as the processor can schedule new transitions which reallocate the array
+        const auto transition = queue->Transitions[ queue->FirstIndex++ ];
+        --PendingTransitionCount;
+
+        if ( queue->IsEmpty() )
+        {
+            queue->Transitions.Reset();
+            queue->FirstIndex = 0;
+        }
+
+        const auto now = FPlatformTime::Seconds();
+        LastDrainMaxLag = FMath::Max( LastDrainMaxLag, now - transition.ScheduleTime );
+
+        processor( transition );
+
+        ++ProcessedTransitionCount;
+        ++LastDrainProcessedTransitionCount;
+
+        if ( budget_seconds > 0.0 && FPlatformTime::Seconds() - start_time >= budget_seconds )
+        {
+            break;
+        }
+    }
+}
+
+void FMSMissionScheduler::Reset()
+{
+    for ( auto & queue : Queues )
+    {
+        queue.Transitions.Reset();
+        queue.FirstIndex = 0;
+    }
+
+    PendingTransitionCount = 0;
+}
@@ -0,0 +1,408 @@
+#include "MSMissionStateTable.h"
+
+int32 FMSMissionStateTable::FindIndex( const FGuid & id ) const
+{
+    if ( FindBoundIndex )
+    {
+        const auto bound_index = FindBoundIndex( id );
+
+        if ( bound_index != INDEX_NONE && bound_index < BoundCount )
+        {
+            return bound_index;
+        }
+    }
+
+    const auto * extra_index = ExtraIndicesById.Find( id );
+    return extra_index != nullptr ? *extra_index : INDEX_NONE;
+}
+
+int32 FMSMissionStateTable::FindOrAddIndex( const FGuid & id )
+{
+    const auto existing_index = FindIndex( id );
+
+    if ( existing_index != INDEX_NONE )
+    {
+        return existing_index;
+    }
+
+    const auto index = BoundCount + ExtraIds.Add( id );
+    ExtraIndicesById.Add( id, index );
+
+    if ( PackedStates.Num() * StatesPerWord < static_cast< uint32 >( Num() ) )
+    {
+        PackedStates.Add( 0 );
+    }
+
+    return index;
+}
+
+void FMSMissionStateTable::SetState( const int32 index, const EMSState state )
+{
+    SetPackedState( index, static_cast< uint32 >( state ) + 1 );
+}
+
+void FMSMissionStateTable::ClearState( const int32 index )
+{
+    SetPackedState( index, 0 );
+}
+
+void FMSMissionStateTable::SetPackedState( const int32 index, const uint32 packed_state )
+{
+    check( index >= 0 && index < Num() );
+
+    const auto shift = ( index % StatesPerWord ) * BitsPerState;
+    auto & word = PackedStates[ index / StatesPerWord ];
+    const auto previous_packed_state = ( word >> shift ) & StateMask;
+
+    StateCount += ( packed_state != 0 ? 1 : 0 ) - ( previous_packed_state != 0 ? 1 : 0 );
+    word = ( word & ~( StateMask << shift ) ) | ( packed_state << shift );
+}
+
+void FMSMissionStateTable::SetBoundCount( const int32 bound_count )
+{
+    check( ExtraIds.Num() == 0 );
+
+    BoundCount = bound_count;
+    PackedStates.SetNumZeroed( FMath::DivideAndRoundUp( static_cast< uint32 >( BoundCount ), StatesPerWord ) );
+}
+
+void FMSMissionStateTable::Bind( const TConstArrayView< FGuid > ids, FFindBoundIndex find_bound_index )
+{
+    if ( BoundIds.GetData() == ids.GetData() && BoundIds.Num() == ids.Num() && BoundCount == ids.Num() )
+    {
+        return;
+    }
+
+    FMSMissionStateTable table;
+    table.BoundIds = ids;
+    table.FindBoundIndex = MoveTemp( find_bound_index );
+    table.SetBoundCount( ids.Num() );
+    table.ExtraIds.Reserve( ExtraIds.Num() );
+    table.ExtraIndicesById.Reserve( ExtraIds.Num() );
+
+    for ( auto index = 0; index < BoundCount; ++index )
+    {
+        const auto packed_state = GetPackedState( index );
+
+        if ( packed_state == 0 )
+        {
+            continue;
+        }
+
+        // The entries loaded before the table was bound have no ID. The graph only appends new entries when it is compiled again, so they keep their index
+        if ( HasId( index ) )
+        {
+            table.SetPackedState( table.FindOrAddIndex( BoundIds[ index ] ), packed_state );
+        }
+        else if ( index < ids.Num() )
+        {
+            table.SetPackedState( index, packed_state );
+        }
+    }
+
+    for ( auto extra_index = 0; extra_index < ExtraIds.Num(); ++extra_index )
+    {
+        const auto new_index = table.FindOrAddIndex( ExtraIds[ extra_index ] );
+        table.SetPackedState( new_index, GetPackedState( BoundCount + extra_index ) );
+    }
+
+    *this = MoveTemp( table );
+}
+
+void FMSMissionStateTable::ClearUnboundStates()
+{
+    for ( auto index = BoundIds.Num(); index < BoundCount; ++index )
+    {
+        SetPackedState( index, 0 );
+    }
+}
+
+void FMSMissionStateTable::Reset()
+{
+    ExtraIds.Reset();
+    ExtraIndicesById.Reset();
+    StateCount = 0;
+
+    SetBoundCount( BoundIds.Num() );
+
+    for ( auto & word : PackedStates )
+    {
+        word = 0;
+    }
+}
+
+SIZE_T FMSMissionStateTable::GetAllocatedSize() const
+{
+    return ExtraIds.GetAllocatedSize() + ExtraIndicesById.GetAllocatedSize() + PackedStates.GetAllocatedSize();
+}
+
+void FMSMissionStateTable::SerializeIndexed( FArchive & archive, TArray< int32 > & saved_indices )
+{
+    if ( archive.IsSaving() )
+    {
+        saved_indices.Reset( Num() );
+
+        uint32 bound_count = BoundCount;
+        archive.SerializeIntPacked( bound_count );
+
+        // Entries without a state are written as 0, so the entries of the graph do not need their index
+        TArray< uint8 > bound_states;
+        bound_states.SetNumZeroed( FMath::DivideAndRoundUp( bound_count, StatesPerByte ) );
+
+        auto bound_state_count = 0;
+
+        for ( auto index = 0; index < BoundCount; ++index )
+        {
+            const auto packed_state = GetPackedState( index );
+
+            bound_states[ index / StatesPerByte ] |= packed_state << ( ( index % StatesPerByte ) * BitsPerState );
+            bound_state_count += packed_state != 0 ? 1 : 0;
+            saved_indices.Add( index );
+        }
+
+        archive.Serialize( bound_states.GetData(), bound_states.Num() );
+
+        uint32 extra_count = StateCount - bound_state_count;
+        archive.SerializeIntPacked( extra_count );
+
+        TArray< uint8 > extra_states;
+        extra_states.SetNumZeroed( FMath::DivideAndRoundUp( extra_count, StatesPerByte ) );
+
+        auto extra_saved_index = 0u;
+
+        for ( auto extra_index = 0; extra_index < ExtraIds.Num(); ++extra_index )
+        {
+            const auto packed_state = GetPackedState( BoundCount + extra_index );
+
+            if ( packed_state == 0 )
+            {
+                saved_indices.Add( INDEX_NONE );
+                continue;
+            }
+
+            saved_indices.Add( bound_count + extra_saved_index );
+            archive << ExtraIds[ extra_index ];
+
+            extra_states[ extra_saved_index / StatesPerByte ] |= ( packed_state - 1 ) << ( ( extra_saved_index % StatesPerByte ) * BitsPerState );
+            ++extra_saved_index;
+        }
+
+        check( extra_saved_index == extra_count );
+        archive.Serialize( extra_states.GetData(), extra_states.Num() );
+        return;
+    }
+
+    Reset();
+
+    uint32 bound_count = 0;
+    archive.SerializeIntPacked( bound_count );
+
+    // Each byte holds the states of 4 entries of the graph, which bounds the count of a valid archive
+    if ( archive.IsError() || ( archive.TotalSize() >= 0 && bound_count > static_cast< uint64 >( archive.TotalSize() ) * StatesPerByte ) )
+    {
+        archive.SetError();
+        return;
+    }
+
+    // :NOTE: A table loaded before it is bound keeps the states of the graph entries at their index, until the graph gives them an ID
+    if ( static_cast< int32 >( bound_count ) > BoundCount )
+    {
+        SetBoundCount( bound_count );
+    }
+
+    TArray< uint8 > bound_states;
+    bound_states.SetNumUninitialized( FMath::DivideAndRoundUp( bound_count, StatesPerByte ) );
+    archive.Serialize( bound_states.GetData(), bound_states.Num() );
+
+    saved_indices.Reset( bound_count );
+
+    for ( auto index = 0; index < static_cast< int32 >( bound_count ) && !archive.IsError(); ++index )
+    {
+        const auto packed_state = ( bound_states[ index / StatesPerByte ] >> ( ( index % StatesPerByte ) * BitsPerState ) ) & StateMask;
+
+        if ( packed_state != 0 )
+        {
+            SetPackedState( index, packed_state );
+        }
+
+        saved_indices.Add( index );
+    }
+
+    uint32 extra_count = 0;
+    archive.SerializeIntPacked( extra_count );
+
+    // Each entry which is not in the graph takes at least the size of its GUID
+    if ( archive.IsError() || ( archive.TotalSize() >= 0 && extra_count > static_cast< uint64 >( archive.TotalSize() ) / sizeof( FGuid ) ) )
+    {
+        archive.SetError();
+        Reset();
+        return;
+    }
+
+    ExtraIds.Reserve( extra_count );
+    ExtraIndicesById.Reserve( extra_count );
+
+    for ( auto extra_index = 0u; extra_index < extra_count; ++extra_index )
+    {
+        FGuid id;
+        archive << id;
+        saved_indices.Add( FindOrAddIndex( id ) );
+    }
+
+    TArray< uint8 > extra_states;
+    extra_states.SetNumUninitialized( FMath::DivideAndRoundUp( extra_count, StatesPerByte ) );
+    archive.Serialize( extra_states.GetData(), extra_states.Num() );
+
+    if ( archive.IsError() )
+    {
+        Reset();
+        return;
+    }
+
+    for ( auto extra_index = 0u; extra_index < extra_count; ++extra_index )
+    {
+        const auto state = ( extra_states[ extra_index / StatesPerByte ] >> ( ( extra_index % StatesPerByte ) * BitsPerState ) ) & StateMask;
+
+        if ( state > static_cast< uint32 >( EMSState::Complete ) )
+        {
+            archive.SetError();
+            Reset();
+            return;
+        }
+
+        SetState( saved_indices[ bound_count + extra_index ], static_cast< EMSState >( state ) );
+    }
+}
+
+void FMSMissionStateTable::SerializeCompact( FArchive & archive, TArray< int32 > & compact_indices )
+{
+    if ( archive.IsSaving() )
+    {
+        compact_indices.Reset( Num() );
+
+        uint32 count = StateCount;
+        archive.SerializeIntPacked( count );
+
+        TArray< uint8 > packed_states;
+        packed_states.SetNumZeroed( FMath::DivideAndRoundUp( count, StatesPerByte ) );
+
+        auto compact_index = 0u;
+
+        for ( auto index = 0; index < Num(); ++index )
+        {
+            const auto packed_state = GetPackedState( index );
+
+            if ( packed_state == 0 )
+            {
+                compact_indices.Add( INDEX_NONE );
+                continue;
+            }
+
+            compact_indices.Add( compact_index );
+
+            auto id = GetId( index );
+            archive << id;
+
+            packed_states[ compact_index / StatesPerByte ] |= ( packed_state - 1 ) << ( ( compact_index % StatesPerByte ) * BitsPerState );
+            ++compact_index;
+        }
+
+        check( compact_index == count );
+        archive.Serialize( packed_states.GetData(), packed_states.Num() );
+        return;
+    }
+
+    Reset();
+
+    uint32 count = 0;
+    archive.SerializeIntPacked( count );
+
+    // Each entry takes at least the size of its GUID, which bounds the count of a valid archive
+    if ( archive.IsError() || ( archive.TotalSize() >= 0 && count > static_cast< uint64 >( archive.TotalSize() ) / sizeof( FGuid ) ) )
+    {
+        archive.SetError();
+        return;
+    }
+
+    compact_indices.Reset( count );
+
+    for ( auto compact_index = 0u; compact_index < count; ++compact_index )
+    {
+        FGuid id;
+        archive << id;
+        compact_indices.Add( FindOrAddIndex( id ) );
+    }
+
+    TArray< uint8 > packed_states;
+    packed_states.SetNumUninitialized( FMath::DivideAndRoundUp( count, StatesPerByte ) );
+    archive.Serialize( packed_states.GetData(), packed_states.Num() );
+
+    if ( archive.IsError() )
+    {
+        Reset();
+        return;
+    }
+
+    for ( auto compact_index = 0u; compact_index < count; ++compact_index )
+    {
+        const auto state = ( packed_states[ compact_index / StatesPerByte ] >> ( ( compact_index % StatesPerByte ) * BitsPerState ) ) & StateMask;
+
+        if ( state > static_cast< uint32 >( EMSState::Complete ) )
+        {
+            archive.SetError();
+            Reset();
+            return;
+        }
+
+        SetState( compact_indices[ compact_index ], static_cast< EMSState >( state ) );
+    }
+}
+
+FArchive & operator<<( FArchive & archive, FMSMissionStateTable & table )
+{
+    constexpr auto StatesPerWord = FMSMissionStateTable::StatesPerWord;
+
+    TArray< FGuid > ids;
+    TArray< uint32 > packed_states;
+
+    if ( archive.IsSaving() )
+    {
+        ids.Reserve( table.Num() );
+
+        for ( auto index = 0; index < table.Num(); ++index )
+        {
+            ids.Add( table.GetId( index ) );
+        }
+
+        packed_states = table.PackedStates;
+        packed_states.SetNum( FMath::DivideAndRoundUp( static_cast< uint32 >( ids.Num() ), StatesPerWord ) );
+    }
+
+    archive << ids;
+    archive << packed_states;
+
+    if ( !archive.IsLoading() )
+    {
+        return archive;
+    }
+
+    table.Reset();
+
+    if ( static_cast< uint32 >( packed_states.Num() ) != FMath::DivideAndRoundUp( static_cast< uint32 >( ids.Num() ), StatesPerWord ) )
+    {
+        archive.SetError();
+        return archive;
+    }
+
+    for ( auto index = 0; index < ids.Num(); ++index )
+    {
+        const auto packed_state = ( packed_states[ index / StatesPerWord ] >> ( ( index % StatesPerWord ) * FMSMissionStateTable::BitsPerState ) ) & FMSMissionStateTable::StateMask;
+
+        if ( packed_state != 0 )
+        {
+            table.SetPackedState( table.FindOrAddIndex( ids[ index ] ), packed_state );
+        }
+    }
+
+    return archive;
+}
@@ -3,52 +3,68 @@
 #include "Log/CoreExtLog.h"
 #include "MSLog.h"
 #include "MSMission.h"
+#include "MSMissionAction.h"
+#include "MSMissionCatalogSubsystem.h"
+#include "MSMissionGraph.h"
+#include "MSProfiling.h"
 #include "MVVMGameSubsystem.h"
 #include "ViewModels/MSViewModel.h"
 
 #include <Engine/GameInstance.h>
 #include <Engine/World.h>
 #include <GameFramework/PlayerController.h>
+#include <HAL/FileManager.h>
+#include <Misc/CoreDelegates.h>
+#include <Misc/FileHelper.h>
+#include <Net/UnrealNetwork.h>
+#include <ProfilingDebugging/CsvProfiler.h>
+#include <Serialization/MemoryReader.h>
 #include <Serialization/MemoryWriter.h>
+#include <TimerManager.h>
 
-#if !( UE_BUILD_SHIPPING || UE_BUILD_TEST )
-static FAutoConsoleCommand SkipMissionsCommand(
-    TEXT( "MissionSystem.SkipMissions" ),
-    TEXT( "Skips the current missions." ),
-    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & /*args*/, const UWorld * world, FOutputDevice & /*output_device*/ ) {
-        for ( auto ite = world->GetPlayerControllerIterator(); ite; ++ite )
-        {
-            if ( auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
-            {
-                component->CancelCurrentMissions();
-            }
-        }
-    } ) );
+static TAutoConsoleVariable< bool > CVarPoolActions( TEXT( "MissionSystem.PoolActions" ),
+    true,
+    TEXT( "Set to false to duplicate the actions of the missions and objectives each time they are executed, instead of reusing the actions of the ended missions." ),
+    ECVF_Default );
 
-static FAutoConsoleCommand CompleteMissionsCommand(
-    TEXT( "MissionSystem.CompleteMissions" ),
-    TEXT( "Completes the current missions." ),
-    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & /*args*/, const UWorld * world, FOutputDevice & /*output_device*/ ) {
+static TAutoConsoleVariable< float > CVarActionDeadline( TEXT( "MissionSystem.ActionDeadline" ),
+    30.0f,
+    TEXT( "Number of seconds after which an action which did not call FinishExecute is reported in the log and in the MissionSystem trace channel. 0 disables the check." ),
+    ECVF_Default );
+
+CSV_DEFINE_CATEGORY( MissionSystem, true );
+
+static FAutoConsoleCommand StatsCommand(
+    TEXT( "MissionSystem.Stats" ),
+    TEXT( "Prints the counters of the mission system components in the log : missions, objectives and actions started and finished, pending observers, history entries and view models." ),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & /*args*/, const UWorld * world, FOutputDevice & output_device ) {
         for ( auto ite = world->GetPlayerControllerIterator(); ite; ++ite )
         {
-            if ( auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
+            if ( const auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
             {
-                component->CompleteCurrentMissions();
+                component->DumpStats( output_device );
             }
         }
     } ) );
 
-static FAutoConsoleCommand ListActiveMissionsCommand(
-    TEXT( "MissionSystem.ListActiveMissions" ),
-    TEXT( "Prints the active missions in the log." ),
-    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & /*args*/, const UWorld * world, FOutputDevice & output_device ) {
+static FAutoConsoleCommand ListActionLatenciesCommand(
+    TEXT( "MissionSystem.ListActionLatencies" ),
+    TEXT( "Prints in the log the action classes which took the longest to finish, and the actions which are still executing, over all the mission system components." )
+        TEXT( "Takes the maximum number of lines of each list as an optional parameter (10 by default, 0 to print everything)." ),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & args, const UWorld * world, FOutputDevice & output_device ) {
+        TArray< const FMSActionLatencyTracker * > trackers;
+
         for ( auto ite = world->GetPlayerControllerIterator(); ite; ++ite )
         {
-            if ( auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
+            if ( const auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
             {
-                component->DumpActiveMissions( output_device );
+                trackers.Add( &component->GetActionLatencyTracker() );
             }
         }
+
+        const auto max_count = args.Num() > 0 ? FCString::Atoi( *args[ 0 ] ) : 10;
+
+        FMSActionLatencyTracker::Dump( trackers, FPlatformTime::Seconds(), max_count, output_device );
     } ) );
 
 static FAutoConsoleCommand IgnoreObjectivesWithTag(
@@ -79,6 +95,46 @@ static FAutoConsoleCommand ClearIgnoreObjectivesTags(
         }
     } ) );
 
+#if !( UE_BUILD_SHIPPING || UE_BUILD_TEST )
+static FAutoConsoleCommand SkipMissionsCommand(
+    TEXT( "MissionSystem.SkipMissions" ),
+    TEXT( "Skips the current missions." ),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & /*args*/, const UWorld * world, FOutputDevice & /*output_device*/ ) {
+        for ( auto ite = world->GetPlayerControllerIterator(); ite; ++ite )
+        {
+            if ( auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
+            {
+                component->CancelCurrentMissions();
+            }
+        }
+    } ) );
+
+static FAutoConsoleCommand CompleteMissionsCommand(
+    TEXT( "MissionSystem.CompleteMissions" ),
+    TEXT( "Completes the current missions." ),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & /*args*/, const UWorld * world, FOutputDevice & /*output_device*/ ) {
+        for ( auto ite = world->GetPlayerControllerIterator(); ite; ++ite )
+        {
+            if ( auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
+            {
+                component->CompleteCurrentMissions();
+            }
+        }
+    } ) );
+
+static FAutoConsoleCommand ListActiveMissionsCommand(
+    TEXT( "MissionSystem.ListActiveMissions" ),
+    TEXT( "Prints the active missions in the log." ),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda( []( const TArray< FString > & /*args*/, const UWorld * world, FOutputDevice & output_device ) {
+        for ( auto ite = world->GetPlayerControllerIterator(); ite; ++ite )
+        {
+            if ( auto * component = ( *ite )->FindComponentByClass< UMSMissionSystemComponent >() )
+            {
+                component->DumpActiveMissions( output_device );
+            }
+        }
+    } ) );
+
 static FAutoConsoleCommand ClearMissionHistory(
     TEXT( "MissionSystem.ClearMissionHistory" ),
     TEXT( "Clears the history of the missions." ),
@@ -99,13 +155,81 @@ static TAutoConsoleVariable< int32 > CVarDisableAllMissions( TEXT( "MissionSyste
 
 #endif
 
+namespace
+{
+    // Starts the mission once the prefetcher has loaded its data and its objectives
+    FMSMissionPrefetcher::FOnMissionLoaded MakeStartMissionCallback( UMSMissionSystemComponent * component )
+    {
+        return [ weak_component = TWeakObjectPtr< UMSMissionSystemComponent >( component ) ]( UMSMissionData * mission_data ) {
+            if ( auto * loaded_component = weak_component.Get() )
+            {
+                loaded_component->ScheduleTransition( FMSMissionTransition::MakeStartMission( mission_data ) );
+            }
+        };
+    }
+
+    FString GetHistoryJournalPath( const FString & file_path )
+    {
+        return file_path + TEXT( ".journal" );
+    }
+
+    // Runs on a background task, and only touches the copy of the history
+    bool WriteHistorySnapshot( const FString & file_path, FGuid snapshot_id, FMSMissionHistory & history )
+    {
+        TArray< uint8 > bytes;
+        FMemoryWriter writer( bytes );
+        writer << snapshot_id;
+        writer << history;
+
+        // Write the snapshot next to the previous one first, so a failed write does not lose the previous snapshot
+        const auto temporary_path = file_path + TEXT( ".tmp" );
+        auto & file_manager = IFileManager::Get();
+
+        if ( writer.IsError() || !FFileHelper::SaveArrayToFile( bytes, *temporary_path ) || !file_manager.Move( *file_path, *temporary_path ) )
+        {
+            UE_LOG( LogMissionSystem, Error, TEXT( "Failed to save the mission history to %s" ), *file_path );
+            return false;
+        }
+
+        file_manager.Delete( *GetHistoryJournalPath( file_path ), false, false, true );
+        return true;
+    }
+
+    bool AppendToHistoryJournal( const FString & file_path, const TArray< uint8 > & entry_bytes )
+    {
+        if ( !FFileHelper::SaveArrayToFile( entry_bytes, *GetHistoryJournalPath( file_path ), &IFileManager::Get(), FILEWRITE_Append ) )
+        {
+            UE_LOG( LogMissionSystem, Error, TEXT( "Failed to append to the mission history journal of %s" ), *file_path );
+            return false;
+        }
+
+        return true;
+    }
+}
+
 UMSMissionSystemComponent::UMSMissionSystemComponent( const FObjectInitializer & object_initializer ) :
     Super( object_initializer ),
     bCreateViewModel( false ),
     bRegisterViewModel( true ),
+    bCreateViewModelsLazily( false ),
     ViewModelContextName( TEXT( "MSViewModel" ) ),
-    bTryResumeMissionFromHistory( true )
+    bTryResumeMissionFromHistory( true ),
+    PrefetchDepth( 1 ),
+    bPoolObjectives( false ),
+    MaxPooledObjectivesPerClass( 4 ),
+    MaxPooledActionsPerTemplate( 4 ),
+    bTimeSliceTransitions( false ),
+    TimeSliceBudget( 2.0f ),
+    bDeferEventDispatch( false ),
+    bReplicateMissionState( true ),
+    MaxHistoryJournalEntries( 256 ),
+    HistoryJournalEntryCount( 0 ),
+    HistorySaveFailed( MakeShared< std::atomic< bool >, ESPMode::ThreadSafe >( false ) )
 {
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+
+    ReplicatedState.SetOwner( this );
 }
 
 bool UMSMissionSystemComponent::HasDataInHistory() const
@@ -122,14 +246,7 @@ void UMSMissionSystemComponent::StartMission( UMSMissionData * mission_data )
     }
 #endif
 
-    auto * mission = TryCreateMissionFromData( mission_data );
-
-    if ( mission == nullptr )
-    {
-        return;
-    }
-
-    StartMission( mission );
+    ScheduleTransition( FMSMissionTransition::MakeStartMission( mission_data ) );
 }
 
 bool UMSMissionSystemComponent::IsMissionComplete( UMSMissionData * mission_data ) const
@@ -144,14 +261,12 @@ bool UMSMissionSystemComponent::IsMissionActive( UMSMissionData * mission_data )
 
 UMSMission * UMSMissionSystemComponent::GetActiveMission( const UMSMissionData * mission_data ) const
 {
-    if ( auto * mission = ActiveMissions.FindByPredicate( [ & ]( const auto * active_mission ) {
-             return active_mission->GetMissionData() == mission_data;
-         } ) )
+    if ( mission_data == nullptr )
     {
-        return *mission;
+        return nullptr;
     }
 
-    return nullptr;
+    return GetActiveMission( mission_data->GetGuid() );
 }
 
 void UMSMissionSystemComponent::CancelCurrentMissions() const
@@ -177,17 +292,27 @@ bool UMSMissionSystemComponent::IsMissionObjectiveActive( const TSubclassOf< UMS
 
 void UMSMissionSystemComponent::ResumeMissionsFromHistory()
 {
-    for ( const auto mission_data : MissionHistory.GetActiveMissionData() )
+    const auto * catalog = UMSMissionCatalogSubsystem::Get();
+
+    if ( !ensureAlways( catalog != nullptr ) )
     {
-        // :NOTE: Bypass the checks of TryCreateMissionFromData
-        auto * mission = CreateMissionFromData( mission_data );
+        return;
+    }
+
+    // :NOTE: Copy the IDs, as missions can end while they are resumed
+    const auto active_mission_ids = MissionHistory.GetActiveMissionIds();
+
+    for ( const auto & mission_id : active_mission_ids )
+    {
+        // The mission data are only loaded now that the mission needs to run
+        auto * mission_data = catalog->LoadMissionData( mission_id );
 
-        if ( mission == nullptr )
+        if ( mission_data == nullptr )
         {
             continue;
         }
 
-        StartMission( mission );
+        ScheduleTransition( FMSMissionTransition::MakeResumeMission( mission_data ) );
     }
 }
 
@@ -201,6 +326,176 @@ bool UMSMissionSystemComponent::CompleteObjective( UMSMissionData * mission_data
     return false;
 }
 
+bool UMSMissionSystemComponent::SaveHistory( const FString & file_path )
+{
+    return SaveHistoryAsync( file_path ).GetResult();
+}
+
+UE::Tasks::TTask< bool > UMSMissionSystemComponent::SaveHistoryAsync( const FString & file_path )
+{
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_SaveHistory );
+    MS_TRACE_SCOPE( "SaveHistory" );
+
+    TUniqueFunction< bool() > write;
+    auto is_journal_entry = false;
+
+    const auto previous_save_failed = HistorySaveFailed->exchange( false );
+
+    // A snapshot is required when the file on disk does not come from this history, when the history was cleared, or when a previous save failed
+    if ( previous_save_failed
+         || !HistorySnapshotId.IsValid()
+         || HistorySnapshotPath != file_path
+         || MissionHistory.NeedsSnapshot()
+         || HistoryJournalEntryCount + MissionHistory.GetChangeCount() > MaxHistoryJournalEntries )
+    {
+        HistorySnapshotId = FGuid::NewGuid();
+        HistorySnapshotPath = file_path;
+        HistoryJournalEntryCount = 0;
+
+        // :NOTE: The copy is the only game thread cost of a snapshot. The history keeps changing while the copy is saved
+        write = [ file_path, snapshot_id = HistorySnapshotId, history = MakeUnique< FMSMissionHistory >( MissionHistory ) ]() {
+            return WriteHistorySnapshot( file_path, snapshot_id, *history );
+        };
+    }
+    else if ( MissionHistory.GetChangeCount() > 0 )
+    {
+        // The changes are few, so they are encoded here rather than copying the history
+        TArray< uint8 > changes_bytes;
+        FMemoryWriter changes_writer( changes_bytes );
+        HistoryJournalEntryCount += MissionHistory.SerializeChanges( changes_writer );
+
+        auto changes_size = changes_bytes.Num();
+
+        TArray< uint8 > entry_bytes;
+        FMemoryWriter entry_writer( entry_bytes );
+        entry_writer << HistorySnapshotId;
+        entry_writer << changes_size;
+        entry_writer.Serialize( changes_bytes.GetData(), changes_size );
+
+        write = [ file_path, entry_bytes = MoveTemp( entry_bytes ) ]() {
+            return AppendToHistoryJournal( file_path, entry_bytes );
+        };
+        is_journal_entry = true;
+    }
+    else
+    {
+        write = []() {
+            return true;
+        };
+    }
+
+    MissionHistory.Checkpoint();
+
+    auto task_body = [ write = MoveTemp( write ), is_journal_entry, save_failed = HistorySaveFailed ]() {
+        MS_TRACE_SCOPE( "WriteHistory" );
+
+        // Each journal entry only applies on top of the previous ones. Once a save failed, the entries launched before the game thread noticed
+        // are dropped, as they would leave a gap in the journal, until the next save writes a snapshot
+        if ( is_journal_entry && save_failed->load() )
+        {
+            return false;
+        }
+
+        const auto result = write();
+
+        if ( !result )
+        {
+            save_failed->store( true );
+        }
+
+        return result;
+    };
+
+    // Saves to the same file must not overlap
+    PendingHistorySave = PendingHistorySave.IsValid()
+                             ? UE::Tasks::Launch( UE_SOURCE_LOCATION, MoveTemp( task_body ), UE::Tasks::Prerequisites( PendingHistorySave ) )
+                             : UE::Tasks::Launch( UE_SOURCE_LOCATION, MoveTemp( task_body ) );
+
+    return PendingHistorySave;
+}
+
+bool UMSMissionSystemComponent::LoadHistory( const FString & file_path )
+{
+    if ( PendingHistorySave.IsValid() )
+    {
+        PendingHistorySave.Wait();
+    }
+
+    TArray< uint8 > bytes;
+    if ( !FFileHelper::LoadFileToArray( bytes, *file_path ) )
+    {
+        return false;
+    }
+
+    FMemoryReader reader( bytes );
+
+    FGuid snapshot_id;
+    reader << snapshot_id;
+    reader << MissionHistory;
+
+    if ( reader.IsError() )
+    {
+        UE_SLOG( LogMissionSystem, Error, TEXT( "Failed to load the mission history from %s" ), *file_path );
+        ClearMissionHistory();
+        return false;
+    }
+
+    HistoryJournalEntryCount = 0;
+
+    TArray< uint8 > journal_bytes;
+    if ( FFileHelper::LoadFileToArray( journal_bytes, *GetHistoryJournalPath( file_path ), FILEREAD_Silent ) )
+    {
+        FMemoryReader journal_reader( journal_bytes );
+
+        while ( !journal_reader.AtEnd() )
+        {
+            FGuid entry_snapshot_id;
+            int32 entry_size = 0;
+
+            journal_reader << entry_snapshot_id;
+            journal_reader << entry_size;
+
+            // The last entry can be truncated if the game stopped while it was written
+            if ( journal_reader.IsError() || entry_size < 0 || journal_reader.Tell() + entry_size > journal_reader.TotalSize() )
+            {
+                UE_SLOG( LogMissionSystem, Warning, TEXT( "Ignored a truncated entry of the mission history journal of %s" ), *file_path );
+                break;
+            }
+
+            const auto entry_offset = journal_reader.Tell();
+            journal_reader.Seek( entry_offset + entry_size );
+
+            // Entries written before the last snapshot are left over when the journal could not be deleted
+            if ( entry_snapshot_id != snapshot_id )
+            {
+                continue;
+            }
+
+            FMemoryReaderView entry_reader( MakeArrayView( journal_bytes.GetData() + entry_offset, entry_size ) );
+            HistoryJournalEntryCount += MissionHistory.SerializeChanges( entry_reader );
+
+            if ( entry_reader.IsError() )
+            {
+                UE_SLOG( LogMissionSystem, Warning, TEXT( "Ignored an invalid entry of the mission history journal of %s" ), *file_path );
+                break;
+            }
+        }
+    }
+
+    MissionHistory.Checkpoint();
+    HistorySnapshotId = snapshot_id;
+    HistorySnapshotPath = file_path;
+
+    if ( MissionGraph != nullptr )
+    {
+        MissionHistory.BindToGraph( *MissionGraph );
+    }
+
+    RebuildReplicatedState();
+
+    return true;
+}
+
 void UMSMissionSystemComponent::WhenMissionStartsOrIsActive( UMSMissionData * mission_data, const FMSMissionSystemMissionStartedDelegate & when_mission_starts )
 {
     if ( IsMissionActive( mission_data ) )
@@ -209,11 +504,7 @@ void UMSMissionSystemComponent::WhenMissionStartsOrIsActive( UMSMissionData * mi
         return;
     }
 
-    FMissionStartObserver observer;
-    observer.MissionData = mission_data;
-    observer.Callback = when_mission_starts;
-
-    MissionStartObservers.Emplace( MoveTemp( observer ) );
+    MissionStartObservers.Add( mission_data, when_mission_starts );
 }
 
 void UMSMissionSystemComponent::WhenMissionEnds( UMSMissionData * mission_data, const FMSMissionSystemMissionEndedDelegate & when_mission_ends )
@@ -224,11 +515,7 @@ void UMSMissionSystemComponent::WhenMissionEnds( UMSMissionData * mission_data,
         return;
     }
 
-    FMissionEndObserver observer;
-    observer.MissionData = mission_data;
-    observer.Callback = when_mission_ends;
-
-    MissionEndObservers.Emplace( MoveTemp( observer ) );
+    MissionEndObservers.Add( mission_data, when_mission_ends );
 }
 
 void UMSMissionSystemComponent::WhenMissionObjectiveStartsOrIsActive( const TSubclassOf< UMSMissionObjective > & mission_objective_class, const FMSMissionSystemMissionObjectiveStartedDelegate & when_mission_objective_starts )
@@ -239,90 +526,390 @@ void UMSMissionSystemComponent::WhenMissionObjectiveStartsOrIsActive( const TSub
         return;
     }
 
-    FMissionObjectiveStartObserver observer;
-    observer.MissionObjective = mission_objective_class;
-    observer.Callback = when_mission_objective_starts;
-
-    MissionObjectiveStartObservers.Emplace( MoveTemp( observer ) );
+    MissionObjectiveStartObservers.Add( mission_objective_class, when_mission_objective_starts );
 }
 
 void UMSMissionSystemComponent::WhenMissionObjectiveEnds( const TSubclassOf< UMSMissionObjective > & mission_objective_class, const FMSMissionSystemMissionObjectiveEndedDelegate & when_mission_objective_ends )
 {
-    FMissionObjectiveEndObserver observer;
-    observer.MissionObjective = mission_objective_class;
-    observer.Callback = when_mission_objective_ends;
+    MissionObjectiveEndObservers.Add( mission_objective_class, when_mission_objective_ends );
+}
+
+void UMSMissionSystemComponent::DumpStats( FOutputDevice & output_device ) const
+{
+    output_device.Logf( ELogVerbosity::Verbose, TEXT( "Mission System - Stats of %s :" ), *GetNameSafe( GetOwner() ) );
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( " * Missions : %llu started - %llu finished - %i active" ),
+        RuntimeCounters.MissionsStarted,
+        RuntimeCounters.MissionsFinished,
+        ActiveMissions.Num() );
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( " * Objectives : %llu started - %llu finished" ),
+        RuntimeCounters.ObjectivesStarted,
+        RuntimeCounters.ObjectivesFinished );
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( " * Actions : %llu started - %llu finished" ),
+        RuntimeCounters.ActionsStarted,
+        RuntimeCounters.ActionsFinished );
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( " * Pending observers : %i mission start - %i mission end - %i objective start - %i objective end" ),
+        MissionStartObservers.Num(),
+        MissionEndObservers.Num(),
+        MissionObjectiveStartObservers.Num(),
+        MissionObjectiveEndObservers.Num() );
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( " * History : %i missions - %i objectives - %i active missions - %i unsaved changes" ),
+        MissionHistory.GetMissionStates().GetStateCount(),
+        MissionHistory.GetObjectiveStates().GetStateCount(),
+        MissionHistory.GetActiveMissionIds().Num(),
+        MissionHistory.GetChangeCount() );
+
+    if ( ViewModel != nullptr )
+    {
+        output_device.Logf( ELogVerbosity::Verbose,
+            TEXT( " * View models : %i missions (%i pooled) - %i objectives (%i pooled)" ),
+            ViewModel->GetMissionViewModelCount(),
+            ViewModel->GetPooledMissionViewModelCount(),
+            ViewModel->GetObjectiveViewModelCount(),
+            ViewModel->GetPooledObjectiveViewModelCount() );
+    }
+}
+
+void UMSMissionSystemComponent::IgnoreObjectivesWithTags( const TArray< FString > & tags )
+{
+    const auto previous_tag_count = TagsToIgnoreForObjectives.Num();
+
+    for ( const auto & tag : tags )
+    {
+        TagsToIgnoreForObjectives.AddUnique( tag );
+    }
+
+    if ( TagsToIgnoreForObjectives.Num() != previous_tag_count )
+    {
+        ObjectiveTagMatcher.Build( TagsToIgnoreForObjectives );
+    }
+
+    if ( ObjectiveTagMatcher.IsEmpty() )
+    {
+        return;
+    }
+
+    for ( auto * active_mission : ActiveMissions )
+    {
+        for ( auto * objective : active_mission->GetObjectives() )
+        {
+            if ( objective->IsComplete() )
+            {
+                continue;
+            }
+
+            if ( MustObjectiveBeIgnored( objective ) )
+            {
+                objective->CompleteObjective();
+            }
+        }
+    }
+}
+
+void UMSMissionSystemComponent::ClearIgnoreObjectivesTags()
+{
+    TagsToIgnoreForObjectives.Reset();
+    ObjectiveTagMatcher.Reset();
+}
+
+bool UMSMissionSystemComponent::MustObjectiveBeIgnored( const UMSMissionObjective * objective ) const
+{
+    if ( ObjectiveTagMatcher.IsEmpty() )
+    {
+        return false;
+    }
+
+    // Through the interface, so the objectives which override GetOwnedGameplayTags are filtered with all their tags
+    ObjectiveTagsBuffer.Reset();
+    objective->GetOwnedGameplayTags( ObjectiveTagsBuffer );
+
+    // Note that it does not need to match exactly. A tag which contains any of the ignored tags is enough to return true
+    return ObjectiveTagMatcher.Matches( ObjectiveTagsBuffer );
+}
+
+#if !( UE_BUILD_SHIPPING || UE_BUILD_TEST )
+void UMSMissionSystemComponent::DumpActiveMissions( FOutputDevice & output_device )
+{
+    output_device.Logf( ELogVerbosity::Verbose, TEXT( "Mission System - Active Missions :" ) );
+    for ( auto * active_mission : ActiveMissions )
+    {
+        active_mission->DumpMission( output_device );
+    }
+
+    if ( bPoolObjectives )
+    {
+        output_device.Logf( ELogVerbosity::Verbose,
+            TEXT( "Mission System - Objective pool : %u hits - %u misses - %i pooled" ),
+            ObjectivePool.GetHitCount(),
+            ObjectivePool.GetMissCount(),
+            ObjectivePool.GetPooledObjectiveCount() );
+    }
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( "Mission System - Action pool : %u hits - %u misses - %i pooled" ),
+        ActionPool.GetHitCount(),
+        ActionPool.GetMissCount(),
+        ActionPool.GetPooledActionCount() );
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( "Mission System - Scheduler : %i pending transitions (max %i) - Queue lag : %.2f ms - Last drain : %i transitions, max lag %.2f ms" ),
+        Scheduler.GetPendingTransitionCount(),
+        Scheduler.GetMaxPendingTransitionCount(),
+        Scheduler.GetQueueLag() * 1000.0,
+        Scheduler.GetLastDrainProcessedTransitionCount(),
+        Scheduler.GetLastDrainMaxLag() * 1000.0 );
+
+    output_device.Logf( ELogVerbosity::Verbose,
+        TEXT( "Mission System - Prefetcher : %i prefetched missions - %i loading requests" ),
+        Prefetcher.GetPrefetchedMissionCount(),
+        Prefetcher.GetLoadingRequestCount() );
+}
+
+#endif
+
+void UMSMissionSystemComponent::TickComponent( const float delta_time, const ELevelTick tick_type, FActorComponentTickFunction * this_tick_function )
+{
+    Super::TickComponent( delta_time, tick_type, this_tick_function );
+
+    DrainTransitions( TimeSliceBudget / 1000.0 );
+}
+
+void UMSMissionSystemComponent::FlushEvents()
+{
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_FlushEvents );
+    MS_TRACE_SCOPE( "FlushEvents" );
+
+    FCoreDelegates::OnEndFrame.Remove( EndFrameDelegateHandle );
+    EndFrameDelegateHandle.Reset();
+
+    // :NOTE: Move the events out, as the listeners can trigger new events, which will be dispatched at the end of the next frame
+    const auto events = MoveTemp( PendingEvents );
+
+    for ( const auto & event : events )
+    {
+        DispatchEventNow( event );
+    }
+
+    if ( events.Num() > 0 )
+    {
+        OnMissionEventsDispatchedDelegate.Broadcast( events );
+    }
+}
+
+void UMSMissionSystemComponent::Serialize( FArchive & archive )
+{
+    Super::Serialize( archive );
+
+    archive << MissionHistory;
+
+    if ( archive.IsLoading() )
+    {
+        if ( MissionGraph != nullptr )
+        {
+            MissionHistory.BindToGraph( *MissionGraph );
+        }
+
+        RebuildReplicatedState();
+
+        // The tags to ignore are serialized, but not the matcher compiled from them. Also called when the component is duplicated
+        ObjectiveTagMatcher.Build( TagsToIgnoreForObjectives );
+    }
+}
+
+void UMSMissionSystemComponent::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & out_lifetime_props ) const
+{
+    Super::GetLifetimeReplicatedProps( out_lifetime_props );
+
+    // The history is only relevant to the player who owns the component
+    DOREPLIFETIME_CONDITION( UMSMissionSystemComponent, ReplicatedState, COND_OwnerOnly );
+}
+
+void UMSMissionSystemComponent::ClearMissionHistory()
+{
+    MissionHistory.Clear();
+    Prefetcher.Reset();
+    MissionsToStartWhenLoaded.Reset();
+
+    if ( MissionGraph != nullptr )
+    {
+        MissionHistory.BindToGraph( *MissionGraph );
+    }
+
+    RebuildReplicatedState();
+}
+
+void UMSMissionSystemComponent::OnReplicatedStateChanged( const FMSReplicatedMissionStateItem & item )
+{
+    ApplyReplicatedState( item, item.State );
+}
+
+void UMSMissionSystemComponent::OnReplicatedStateRemoved( const FMSReplicatedMissionStateItem & item )
+{
+    ApplyReplicatedState( item, {} );
+}
+
+void UMSMissionSystemComponent::ScheduleTransition( FMSMissionTransition && transition )
+{
+    Scheduler.Enqueue( MoveTemp( transition ) );
+
+    if ( !bTimeSliceTransitions )
+    {
+        DrainTransitions( 0.0 );
+    }
+}
+
+UMSMissionObjective * UMSMissionSystemComponent::AcquireObjective( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective_class )
+{
+    if ( !bPoolObjectives )
+    {
+        return NewObject< UMSMissionObjective >( mission, objective_class );
+    }
+
+    // Pooled objectives are outered to the component while they are in the pool, and to their mission while they execute
+    return ObjectivePool.Acquire( mission, objective_class );
+}
+
+void UMSMissionSystemComponent::ReleaseObjective( UMSMissionObjective * objective )
+{
+    if ( !bPoolObjectives || objective == nullptr )
+    {
+        return;
+    }
+
+    ScheduleFlushReleasedObjects();
+    ReleasedObjectives.Add( objective );
+}
+
+UMSMissionAction * UMSMissionSystemComponent::AcquireAction( const UMSMissionAction * action_template )
+{
+    // Pooled actions outlive the mission or the objective which executes them, so they are outered to the component
+    return ActionPool.Acquire( this, action_template, CVarPoolActions.GetValueOnGameThread() );
+}
+
+void UMSMissionSystemComponent::ReleaseAction( UMSMissionAction * action )
+{
+    if ( !CVarPoolActions.GetValueOnGameThread() || action == nullptr )
+    {
+        return;
+    }
+
+    ScheduleFlushReleasedObjects();
+    ReleasedActions.Add( action );
+}
+
+void UMSMissionSystemComponent::RecordActionStarted( const UMSMissionAction & action )
+{
+    ++RuntimeCounters.ActionsStarted;
+    ActionLatencyTracker.OnActionStarted( action, FPlatformTime::Seconds() );
+
+    if ( CVarActionDeadline.GetValueOnGameThread() > 0.0f && !ActionDeadlineTimerHandle.IsValid() )
+    {
+        if ( auto * world = GetWorld() )
+        {
+            world->GetTimerManager().SetTimer( ActionDeadlineTimerHandle, this, &UMSMissionSystemComponent::CheckActionDeadlines, 1.0f, true );
+        }
+    }
+}
+
+void UMSMissionSystemComponent::RecordActionFinished( const UMSMissionAction & action )
+{
+    ++RuntimeCounters.ActionsFinished;
+
+    const auto time = FPlatformTime::Seconds();
+    const auto outstanding_action = ActionLatencyTracker.OnActionFinished( action, time );
+
+    if ( !outstanding_action.IsSet() )
+    {
+        return;
+    }
 
-    MissionObjectiveEndObservers.Emplace( MoveTemp( observer ) );
-}
+    const auto latency = time - outstanding_action->StartTime;
+    const auto deadline = CVarActionDeadline.GetValueOnGameThread();
 
-#if !( UE_BUILD_SHIPPING || UE_BUILD_TEST )
-void UMSMissionSystemComponent::DumpActiveMissions( FOutputDevice & output_device )
-{
-    output_device.Logf( ELogVerbosity::Verbose, TEXT( "Mission System - Active Missions :" ) );
-    for ( auto * active_mission : ActiveMissions )
+    // Actions which pass the deadline between two checks are reported when they finish
+    if ( deadline > 0.0f && latency > deadline && !outstanding_action->bPassedDeadline )
     {
-        active_mission->DumpMission( output_device );
+        UE_SLOG( LogMissionSystem, Warning, TEXT( "Action %s took %.1f seconds to call FinishExecute" ), *action.GetDescription(), latency );
+        MS_TRACE_EVENT( ActionPastDeadline, &action, latency );
     }
 }
 
-void UMSMissionSystemComponent::IgnoreObjectivesWithTags( const TArray< FString > & tags )
+void UMSMissionSystemComponent::RecordActionCancelled( const UMSMissionAction & action )
 {
-    for ( const auto & tag : tags )
+    ActionLatencyTracker.OnActionCancelled( action );
+}
+
+void UMSMissionSystemComponent::CheckActionDeadlines()
+{
+    const auto deadline = CVarActionDeadline.GetValueOnGameThread();
+
+    if ( deadline <= 0.0f || ActionLatencyTracker.GetOutstandingActions().Num() == 0 )
     {
-        TagsToIgnoreForObjectives.AddUnique( tag );
+        if ( auto * world = GetWorld() )
+        {
+            world->GetTimerManager().ClearTimer( ActionDeadlineTimerHandle );
+        }
+
+        return;
     }
 
-    for ( auto * active_mission : ActiveMissions )
+    const auto time = FPlatformTime::Seconds();
+
+    for ( const auto & outstanding_action : ActionLatencyTracker.GetActionsPastDeadline( time, deadline ) )
     {
-        for ( auto * objective : active_mission->GetObjectives() )
+        if ( const auto * action = outstanding_action.Action.Get() )
         {
-            if ( objective->IsComplete() )
-            {
-                continue;
-            }
+            const auto latency = time - outstanding_action.StartTime;
 
-            if ( MustObjectiveBeIgnored( objective ) )
-            {
-                objective->CompleteObjective();
-            }
+            UE_SLOG( LogMissionSystem, Warning, TEXT( "Action %s did not call FinishExecute %.1f seconds after it was executed. Its mission is stalled until it does" ), *action->GetDescription(), latency );
+            MS_TRACE_EVENT( ActionPastDeadline, action, latency );
         }
     }
 }
 
-void UMSMissionSystemComponent::ClearIgnoreObjectivesTags()
+void UMSMissionSystemComponent::ScheduleFlushReleasedObjects()
 {
-    TagsToIgnoreForObjectives.Reset();
-}
+    if ( ReleasedObjectives.Num() > 0 || ReleasedActions.Num() > 0 )
+    {
+        return;
+    }
 
-bool UMSMissionSystemComponent::MustObjectiveBeIgnored( const UMSMissionObjective * objective ) const
-{
-    FGameplayTagContainer objective_tag_container;
-    objective->GetOwnedGameplayTags( objective_tag_container );
+    auto * world = GetWorld();
 
-    TArray< FGameplayTag > objective_tags;
-    objective_tag_container.GetGameplayTagArray( objective_tags );
+    // Without a world, there is no next tick : the released objects stay queued until the owner of the component calls FlushReleasedObjects
+    if ( world == nullptr )
+    {
+        UE_LOG( LogMissionSystem, Verbose, TEXT( "%s has no world to return the released objectives and actions to their pools on the next tick. They are not pooled until FlushReleasedObjects is called" ), *GetPathName() );
+        return;
+    }
 
-    // Look in the tags of the objective if we can find one that contains any of the ignored tags
-    // Note that it does not need to match exactly. A substring is enough to return true
-    return objective_tags.FindByPredicate( [ this ]( const FGameplayTag & tag ) {
-        const auto objective_tag_name = tag.ToString();
-        return TagsToIgnoreForObjectives.ContainsByPredicate( [ &objective_tag_name ]( const FString & tag_to_ignore ) {
-            return objective_tag_name.Contains( tag_to_ignore );
-        } );
-    } ) != nullptr;
+    world->GetTimerManager().SetTimerForNextTick( this, &UMSMissionSystemComponent::FlushReleasedObjects );
 }
-#endif
 
-void UMSMissionSystemComponent::Serialize( FArchive & archive )
+void UMSMissionSystemComponent::FlushReleasedObjects()
 {
-    Super::Serialize( archive );
+    for ( const auto & objective : ReleasedObjectives )
+    {
+        ObjectivePool.Release( objective, this, MaxPooledObjectivesPerClass );
+    }
 
-    archive << MissionHistory;
-}
+    ReleasedObjectives.Reset();
 
-void UMSMissionSystemComponent::ClearMissionHistory()
-{
-    MissionHistory.Clear();
+    for ( const auto & action : ReleasedActions )
+    {
+        ActionPool.Release( action, MaxPooledActionsPerTemplate );
+    }
+
+    ReleasedActions.Reset();
 }
 
 void UMSMissionSystemComponent::TryResumeMissionFromHistory()
@@ -351,9 +938,25 @@ void UMSMissionSystemComponent::OnRegister()
 {
     Super::OnRegister();
 
-    if ( bCreateViewModel )
+    SetComponentTickEnabled( bTimeSliceTransitions );
+    SetIsReplicated( bReplicateMissionState );
+
+#if CSV_PROFILER
+    CsvEndFrameDelegateHandle = FCoreDelegates::OnEndFrame.AddUObject( this, &UMSMissionSystemComponent::RecordCsvStats );
+#endif
+
+    if ( MissionGraph != nullptr )
+    {
+        MissionHistory.BindToGraph( *MissionGraph );
+    }
+
+    RebuildReplicatedState();
+
+    // There is no UI on dedicated servers
+    if ( bCreateViewModel && !IsNetMode( NM_DedicatedServer ) )
     {
         ViewModel = NewObject< UMSViewModel >( this );
+        ViewModel->Initialize( bCreateViewModelsLazily );
 
         if ( bRegisterViewModel )
         {
@@ -369,6 +972,23 @@ void UMSMissionSystemComponent::OnRegister()
     }
 }
 
+void UMSMissionSystemComponent::OnUnregister()
+{
+    FlushEvents();
+    Prefetcher.Reset();
+    MissionsToStartWhenLoaded.Reset();
+
+    FCoreDelegates::OnEndFrame.Remove( CsvEndFrameDelegateHandle );
+    CsvEndFrameDelegateHandle.Reset();
+
+    if ( auto * world = GetWorld() )
+    {
+        world->GetTimerManager().ClearTimer( ActionDeadlineTimerHandle );
+    }
+
+    Super::OnUnregister();
+}
+
 void UMSMissionSystemComponent::K2_WhenMissionStartsOrIsActive( UMSMissionData * mission_data, FMSMissionSystemMissionStartedDynamicDelegate when_mission_starts )
 {
     const auto active_delegate = FMSMissionSystemMissionStartedDelegate::CreateWeakLambda( when_mission_starts.GetUObject(), [ when_mission_starts ]( const UMSMissionData * mission_data ) {
@@ -405,6 +1025,95 @@ void UMSMissionSystemComponent::K2_WhenMissionObjectiveEnds( TSubclassOf< UMSMis
     WhenMissionObjectiveEnds( mission_objective, ended_delegate );
 }
 
+UMSMission * UMSMissionSystemComponent::GetActiveMission( const FGuid & mission_id ) const
+{
+    if ( auto * const * mission = ActiveMissionsById.Find( mission_id ) )
+    {
+        return *mission;
+    }
+
+    return nullptr;
+}
+
+void UMSMissionSystemComponent::DrainTransitions( const double budget_seconds )
+{
+    Scheduler.Drain(
+        [ this ]( const FMSMissionTransition & transition ) {
+            ProcessTransition( transition );
+        },
+        budget_seconds );
+}
+
+void UMSMissionSystemComponent::ProcessTransition( const FMSMissionTransition & transition )
+{
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_ProcessTransition );
+    MS_TRACE_SCOPE( "ProcessTransition" );
+
+    switch ( transition.Type )
+    {
+        case EMSMissionTransitionType::StartMission:
+        {
+            if ( auto * mission = TryCreateMissionFromData( transition.MissionData ) )
+            {
+                StartMission( mission );
+            }
+        }
+        break;
+        case EMSMissionTransitionType::ResumeMission:
+        {
+            // :NOTE: Bypass the checks of TryCreateMissionFromData
+            if ( auto * mission = CreateMissionFromData( transition.MissionData ) )
+            {
+                StartMission( mission );
+            }
+        }
+        break;
+        case EMSMissionTransitionType::StartNextMissions:
+        {
+            if ( transition.MissionData != nullptr )
+            {
+                StartNextMissions( transition.MissionData );
+            }
+            else
+            {
+                StartNextMissions( transition.MissionIndex );
+            }
+        }
+        break;
+        case EMSMissionTransitionType::ExecuteNextObjective:
+        {
+            auto * mission = transition.Mission.Get();
+
+            // The mission can have been cancelled or have ended since the transition was scheduled
+            if ( mission != nullptr && GetActiveMission( mission->GetMissionData() ) == mission )
+            {
+                mission->ExecuteNextObjective();
+            }
+        }
+        break;
+        case EMSMissionTransitionType::ExecuteAction:
+        {
+            auto * action = transition.Action.Get();
+
+            // The executor of the action unbinds from it when its mission or its objective is released, and a released action which was reused has a new generation
+            if ( IsValid( action ) && action->GetGeneration() == transition.ActionGeneration && action->OnMissionActionComplete().IsBound() )
+            {
+                MS_TRACE_NAMED_SCOPE( "ExecuteAction", FMSTrace::GetActionName( action ) );
+                MS_TRACE_EVENT( ActionExecuted, action );
+
+                RecordActionStarted( *action );
+                action->Execute();
+            }
+        }
+        break;
+        default:
+        {
+            checkNoEntry();
+        }
+        break;
+    }
+}
+
 UMSMission * UMSMissionSystemComponent::TryCreateMissionFromData( UMSMissionData * mission_data )
 {
     if ( mission_data == nullptr )
@@ -413,6 +1122,11 @@ UMSMission * UMSMissionSystemComponent::TryCreateMissionFromData( UMSMissionData
         return nullptr;
     }
 
+    // The load of the mission is consumed here. A mission which starts references its data and its objective classes, and the assets of the other ones are no longer needed
+    const FSoftObjectPath mission_path( mission_data );
+    MissionsToStartWhenLoaded.Remove( mission_path );
+    Prefetcher.Release( mission_path );
+
     const auto mission_id = mission_data->GetGuid();
     if ( !mission_id.IsValid() )
     {
@@ -432,24 +1146,40 @@ UMSMission * UMSMissionSystemComponent::TryCreateMissionFromData( UMSMissionData
         return nullptr;
     }
 
-    check( ActiveMissions.FindByPredicate( [ mission_data ]( const auto * mission ) {
-        return mission->GetMissionData() == mission_data;
-    } ) == nullptr );
+    check( !ActiveMissionsById.Contains( mission_id ) );
+
+    const auto mission_index = MissionGraph != nullptr ? MissionGraph->FindMissionIndex( mission_id ) : INDEX_NONE;
 
-    for ( const auto * mission_to_cancel : mission_data->MissionsToCancel )
+    if ( mission_index != INDEX_NONE )
     {
-        if ( const auto * active_mission_to_cancel_ptr = ActiveMissions.FindByPredicate( [ & ]( auto * active_mission ) {
-                 return mission_to_cancel == active_mission->GetMissionData();
-             } ) )
+        CancelMissions( mission_index );
+
+        if ( !MissionGraph->GetMission( mission_index ).bEnabled )
         {
-            ( *active_mission_to_cancel_ptr )->Cancel();
+            StartNextMissions( mission_index );
+            return nullptr;
         }
     }
-
-    if ( !mission_data->bEnabled )
+    else
     {
-        StartNextMissions( mission_data );
-        return nullptr;
+        for ( const auto & mission_to_cancel : mission_data->MissionsToCancel )
+        {
+            // :NOTE: Active missions are loaded, so a mission which is not in memory cannot be active
+            if ( auto * active_mission_to_cancel = GetActiveMission( mission_to_cancel.Get() ) )
+            {
+                active_mission_to_cancel->Cancel();
+            }
+            else
+            {
+                ReleasePrefetchedMission( mission_to_cancel.ToSoftObjectPath() );
+            }
+        }
+
+        if ( !mission_data->bEnabled )
+        {
+            StartNextMissions( mission_data );
+            return nullptr;
+        }
     }
 
     if ( !MissionHistory.AddActiveMission( mission_data ) )
@@ -457,6 +1187,8 @@ UMSMission * UMSMissionSystemComponent::TryCreateMissionFromData( UMSMissionData
         return nullptr;
     }
 
+    ReplicateMissionState( mission_data );
+
     return CreateMissionFromData( mission_data );
 }
 
@@ -465,11 +1197,15 @@ UMSMission * UMSMissionSystemComponent::CreateMissionFromData( UMSMissionData *
     auto * mission = NewObject< UMSMission >( this );
     mission->Initialize( mission_data );
 
+    // The mission now references its data and its objective classes. The resumed missions are not created through TryCreateMissionFromData
+    Prefetcher.Release( FSoftObjectPath( mission_data ) );
+
     mission->OnMissionEnded().AddUObject( this, &UMSMissionSystemComponent::OnMissionEnded );
     mission->OnMissionObjectiveStarted().AddUObject( this, &UMSMissionSystemComponent::OnMissionObjectiveStarted, mission );
     mission->OnMissionObjectiveEnded().AddUObject( this, &UMSMissionSystemComponent::OnMissionObjectiveEnded, mission );
 
     ActiveMissions.Add( mission );
+    ActiveMissionsById.Add( mission_data->GetGuid(), mission );
 
     return mission;
 }
@@ -478,21 +1214,103 @@ void UMSMissionSystemComponent::StartMission( UMSMission * mission )
 {
     auto * mission_data = mission->GetMissionData();
 
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_StartMission );
+    MS_TRACE_NAMED_SCOPE( "StartMission", FMSTrace::GetObjectName( mission_data ) );
+    MS_TRACE_EVENT( MissionStarted, mission_data );
+
     UE_SLOG( LogMissionSystem, Verbose, TEXT( "Start mission (%s)" ), *GetNameSafe( mission_data ) );
 
+    ++RuntimeCounters.MissionsStarted;
+
     // :NOTE: This is intended to broadcast now before actually starting the mission
     // This is to make sure no objectives have been started yet, and that any object listening to the
     // events mission started / objective started receive them in the correct order
     BroadcastOnMissionStarted( mission );
 
+    // Load the next missions while this one runs. Before starting it, as it can end right away
+    PrefetchNextMissions( mission_data );
+
     mission->Start();
 }
 
 void UMSMissionSystemComponent::StartNextMissions( const UMSMissionData * mission_data )
 {
-    for ( auto * next_mission : mission_data->NextMissions )
+    if ( MissionGraph != nullptr )
+    {
+        const auto mission_index = MissionGraph->FindMissionIndex( mission_data->GetGuid() );
+
+        if ( mission_index != INDEX_NONE )
+        {
+            StartNextMissions( mission_index );
+            return;
+        }
+    }
+
+    for ( const auto & next_mission : mission_data->NextMissions )
+    {
+        // :NOTE: Added before the load, as the callback is called immediately when the mission is already loaded
+        MissionsToStartWhenLoaded.Add( next_mission.ToSoftObjectPath() );
+        Prefetcher.LoadMission( next_mission, MakeStartMissionCallback( this ) );
+    }
+}
+
+void UMSMissionSystemComponent::StartNextMissions( const int32 mission_index )
+{
+    for ( const auto next_mission_index : MissionGraph->GetNextMissions( mission_index ) )
+    {
+        // Go through disabled missions without loading their data
+        if ( !MissionGraph->GetMission( next_mission_index ).bEnabled )
+        {
+            CancelMissions( next_mission_index );
+            ScheduleTransition( FMSMissionTransition::MakeStartNextMissions( next_mission_index ) );
+            continue;
+        }
+
+        MissionsToStartWhenLoaded.Add( MissionGraph->GetMission( next_mission_index ).MissionData.ToSoftObjectPath() );
+        Prefetcher.LoadMission( *MissionGraph, next_mission_index, MakeStartMissionCallback( this ) );
+    }
+}
+
+void UMSMissionSystemComponent::PrefetchNextMissions( const UMSMissionData * mission_data )
+{
+    if ( PrefetchDepth <= 0 )
+    {
+        return;
+    }
+
+    const auto mission_index = MissionGraph != nullptr ? MissionGraph->FindMissionIndex( mission_data->GetGuid() ) : INDEX_NONE;
+
+    if ( mission_index != INDEX_NONE )
+    {
+        Prefetcher.PrefetchNextMissions( *MissionGraph, mission_index, PrefetchDepth );
+    }
+    else
+    {
+        Prefetcher.PrefetchNextMissions( *mission_data, PrefetchDepth );
+    }
+}
+
+void UMSMissionSystemComponent::CancelMissions( const int32 mission_index )
+{
+    for ( const auto mission_to_cancel_index : MissionGraph->GetMissionsToCancel( mission_index ) )
+    {
+        if ( auto * active_mission_to_cancel = GetActiveMission( MissionGraph->GetMissionIds()[ mission_to_cancel_index ] ) )
+        {
+            active_mission_to_cancel->Cancel();
+        }
+        else
+        {
+            ReleasePrefetchedMission( MissionGraph->GetMission( mission_to_cancel_index ).MissionData.ToSoftObjectPath() );
+        }
+    }
+}
+
+void UMSMissionSystemComponent::ReleasePrefetchedMission( const FSoftObjectPath & mission_path )
+{
+    // :NOTE: A cancelled mission is not prevented from starting. One which waits for its load starts once loaded, and releases its assets then
+    if ( !MissionsToStartWhenLoaded.Contains( mission_path ) )
     {
-        StartMission( next_mission );
+        Prefetcher.Release( mission_path );
     }
 }
 
@@ -500,6 +1318,10 @@ void UMSMissionSystemComponent::OnMissionEnded( UMSMission * mission, const bool
 {
     auto * mission_data = mission->GetMissionData();
 
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_EndMission );
+    MS_TRACE_NAMED_SCOPE( "EndMission", FMSTrace::GetObjectName( mission_data ) );
+    MS_TRACE_EVENT( MissionEnded, mission_data, was_cancelled );
+
     UE_SLOG( LogMissionSystem, Verbose, TEXT( "OnMissionEnded (%s)" ), *GetNameSafe( mission_data ) );
 
     if ( !ensureAlways( MissionHistory.SetMissionComplete( mission_data, was_cancelled ) ) )
@@ -507,33 +1329,41 @@ void UMSMissionSystemComponent::OnMissionEnded( UMSMission * mission, const bool
         return;
     }
 
-    ActiveMissions.Remove( mission );
+    ++RuntimeCounters.MissionsFinished;
 
-    BroadcastOnMissionEnded( mission, was_cancelled );
+    ReplicateMissionState( mission_data );
 
-    if ( ViewModel != nullptr )
-    {
-        ViewModel->SetMissionEnded( mission );
-    }
+    ActiveMissions.RemoveSingle( mission );
+    ActiveMissionsById.Remove( mission_data->GetGuid() );
+
+    BroadcastOnMissionEnded( mission, was_cancelled );
 
     if ( !was_cancelled || mission_data->bStartNextMissionsWhenCancelled )
     {
-        StartNextMissions( mission_data );
+        ScheduleTransition( FMSMissionTransition::MakeStartNextMissions( mission_data ) );
     }
 }
 
 void UMSMissionSystemComponent::OnMissionObjectiveStarted( const TSubclassOf< UMSMissionObjective > & objective, UMSMission * mission )
 {
+    MS_TRACE_EVENT( ObjectiveStarted, objective.Get() );
+
     if ( !ensureAlways( MissionHistory.AddActiveObjective( objective ) ) )
     {
         return;
     }
 
+    ++RuntimeCounters.ObjectivesStarted;
+
+    ReplicateObjectiveState( objective );
+
     BroadcastOnMissionObjectiveStarted( mission, objective );
 }
 
 void UMSMissionSystemComponent::OnMissionObjectiveEnded( const TSubclassOf< UMSMissionObjective > & objective, const bool was_cancelled, UMSMission * mission )
 {
+    MS_TRACE_EVENT( ObjectiveEnded, objective.Get(), was_cancelled );
+
     UE_SLOG( LogMissionSystem, Verbose, TEXT( "OnObjectiveEnded (%s)" ), *objective->GetClass()->GetName() );
 
     if ( !ensureAlways( MissionHistory.SetObjectiveComplete( objective, was_cancelled ) ) )
@@ -541,87 +1371,202 @@ void UMSMissionSystemComponent::OnMissionObjectiveEnded( const TSubclassOf< UMSM
         return;
     }
 
+    ++RuntimeCounters.ObjectivesFinished;
+
+    ReplicateObjectiveState( objective );
+
     BroadcastOnMissionObjectiveEnded( mission, objective, was_cancelled );
 }
 
 void UMSMissionSystemComponent::BroadcastOnMissionStarted( UMSMission * mission )
 {
-    const auto * mission_data = mission->GetMissionData();
+    DispatchEvent( FMSMissionEvent( EMSMissionEventType::MissionStarted, mission ) );
+}
+
+void UMSMissionSystemComponent::BroadcastOnMissionEnded( UMSMission * mission, bool was_cancelled )
+{
+    DispatchEvent( FMSMissionEvent( EMSMissionEventType::MissionEnded, mission, nullptr, was_cancelled ) );
+}
+
+void UMSMissionSystemComponent::BroadcastOnMissionObjectiveStarted( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective )
+{
+    DispatchEvent( FMSMissionEvent( EMSMissionEventType::ObjectiveStarted, mission, objective ) );
+}
 
-    OnMissionStartedDelegate.Broadcast( mission );
+void UMSMissionSystemComponent::BroadcastOnMissionObjectiveEnded( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective, bool was_cancelled )
+{
+    DispatchEvent( FMSMissionEvent( EMSMissionEventType::ObjectiveEnded, mission, objective, was_cancelled ) );
+}
 
-    for ( auto index = MissionStartObservers.Num() - 1; index >= 0; --index )
+void UMSMissionSystemComponent::DispatchEvent( FMSMissionEvent && event )
+{
+    if ( !bDeferEventDispatch )
     {
-        auto & observer = MissionStartObservers[ index ];
+        DispatchEventNow( event );
 
-        if ( observer.MissionData == mission_data )
+        if ( OnMissionEventsDispatchedDelegate.IsBound() )
         {
-            observer.Callback.ExecuteIfBound( mission_data );
-            MissionStartObservers.RemoveAt( index );
+            OnMissionEventsDispatchedDelegate.Broadcast( { event } );
         }
+
+        return;
     }
 
-    if ( ViewModel != nullptr )
+    if ( !EndFrameDelegateHandle.IsValid() )
     {
-        ViewModel->SetMissionStarted( mission );
+        EndFrameDelegateHandle = FCoreDelegates::OnEndFrame.AddUObject( this, &UMSMissionSystemComponent::FlushEvents );
     }
+
+    PendingEvents.Emplace( MoveTemp( event ) );
 }
 
-void UMSMissionSystemComponent::BroadcastOnMissionEnded( UMSMission * mission, bool was_cancelled )
+void UMSMissionSystemComponent::DispatchEventNow( const FMSMissionEvent & event )
 {
-    auto * mission_data = mission->GetMissionData();
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_DispatchEvent );
+    MS_TRACE_SCOPE( "DispatchEvent" );
 
-    OnMissionEndedDelegate.Broadcast( mission_data, was_cancelled );
+    auto * mission = event.Mission.Get();
+    const auto * mission_data = event.MissionData.Get();
 
-    for ( auto index = MissionEndObservers.Num() - 1; index >= 0; --index )
+    switch ( event.Type )
     {
-        auto & observer = MissionEndObservers[ index ];
+        case EMSMissionEventType::MissionStarted:
+        {
+            OnMissionStartedDelegate.Broadcast( mission );
+
+            MissionStartObservers.Broadcast( mission_data, mission_data );
+
+            if ( ViewModel != nullptr )
+            {
+                ViewModel->SetMissionStarted( mission );
+            }
+        }
+        break;
+        case EMSMissionEventType::MissionEnded:
+        {
+            OnMissionEndedDelegate.Broadcast( mission_data, event.bWasCancelled );
+
+            MissionEndObservers.Broadcast( mission_data, mission_data, event.bWasCancelled );
+
+            if ( ViewModel != nullptr )
+            {
+                ViewModel->SetMissionEnded( mission );
+            }
+        }
+        break;
+        case EMSMissionEventType::ObjectiveStarted:
+        {
+            OnMissionObjectiveStartedDelegate.Broadcast( mission_data, event.Objective );
+
+            MissionObjectiveStartObservers.Broadcast( event.Objective, event.Objective );
+
+            if ( ViewModel != nullptr )
+            {
+                ViewModel->SetMissionObjectiveStarted( mission, event.Objective );
+            }
+        }
+        break;
+        case EMSMissionEventType::ObjectiveEnded:
+        {
+            OnMissionObjectiveEndedDelegate.Broadcast( mission_data, event.Objective, event.bWasCancelled );
+
+            MissionObjectiveEndObservers.Broadcast( event.Objective, event.Objective, event.bWasCancelled );
 
-        if ( observer.MissionData == mission_data )
+            if ( ViewModel != nullptr )
+            {
+                ViewModel->SetMissionObjectiveEnded( mission, event.Objective );
+            }
+        }
+        break;
+        default:
         {
-            observer.Callback.ExecuteIfBound( mission_data, was_cancelled );
-            MissionEndObservers.RemoveAt( index );
+            checkNoEntry();
         }
+        break;
     }
+}
 
-    if ( ViewModel != nullptr )
+bool UMSMissionSystemComponent::IsReplicatingMissionState() const
+{
+    return bReplicateMissionState && GetIsReplicated() && GetOwnerRole() == ROLE_Authority;
+}
+
+void UMSMissionSystemComponent::ReplicateMissionState( UMSMissionData * mission_data )
+{
+    if ( IsReplicatingMissionState() )
     {
-        ViewModel->SetMissionEnded( mission );
+        ReplicatedState.UpdateMission( MissionHistory, MissionHistory.FindMissionIndex( mission_data ) );
     }
 }
 
-void UMSMissionSystemComponent::BroadcastOnMissionObjectiveStarted( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective )
+void UMSMissionSystemComponent::ReplicateObjectiveState( const TSubclassOf< UMSMissionObjective > & objective )
 {
-    OnMissionObjectiveStartedDelegate.Broadcast( mission->GetMissionData(), objective );
-
-    for ( auto & observer : MissionObjectiveStartObservers )
+    if ( IsReplicatingMissionState() )
     {
-        observer.Callback.ExecuteIfBound( objective->GetClass() );
+        ReplicatedState.UpdateObjective( MissionHistory, MissionHistory.FindObjectiveIndex( objective ) );
     }
+}
 
-    if ( ViewModel != nullptr )
+void UMSMissionSystemComponent::RebuildReplicatedState()
+{
+    if ( IsReplicatingMissionState() )
     {
-        ViewModel->SetMissionObjectiveStarted( mission, objective );
+        ReplicatedState.Rebuild( MissionHistory );
     }
 }
 
-void UMSMissionSystemComponent::BroadcastOnMissionObjectiveEnded( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective, bool was_cancelled )
+void UMSMissionSystemComponent::ApplyReplicatedState( const FMSReplicatedMissionStateItem & item, const TOptional< EMSState > state )
 {
-    OnMissionObjectiveEndedDelegate.Broadcast( mission->GetMissionData(), objective, was_cancelled );
+    const auto & table = item.bIsObjective ? MissionHistory.GetObjectiveStates() : MissionHistory.GetMissionStates();
+    const auto graph_count = item.bIsObjective ? MissionHistory.GetGraphObjectiveCount() : MissionHistory.GetGraphMissionCount();
+
+    // Entries of the mission graph are only identified by their index, which requires the client to use the same graph as the server
+    if ( item.bIsInGraph && !ensureAlwaysMsgf( item.Index >= 0 && item.Index < graph_count && table.HasId( item.Index ), TEXT( "The mission graph of the client does not match the one of the server" ) ) )
+    {
+        return;
+    }
+
+    const auto id = item.bIsInGraph ? table.GetId( item.Index ) : item.Id;
 
-    for ( auto index = MissionObjectiveEndObservers.Num() - 1; index >= 0; --index )
+    if ( item.bIsObjective )
     {
-        auto & observer = MissionObjectiveEndObservers[ index ];
+        MissionHistory.SetObjectiveState( id, state );
+    }
+    else
+    {
+        MissionHistory.SetMissionState( id, state );
+    }
 
-        if ( observer.MissionObjective == objective->GetClass() )
-        {
-            observer.Callback.ExecuteIfBound( objective->GetClass(), was_cancelled );
-            MissionObjectiveEndObservers.RemoveAt( index );
-        }
+    OnReplicatedMissionStateChangedEvent.Broadcast( id, item.bIsObjective, state );
+}
+
+void UMSMissionSystemComponent::RecordCsvStats()
+{
+#if CSV_PROFILER
+    if ( !FCsvProfiler::Get()->IsCapturing() )
+    {
+        return;
     }
 
+    // :NOTE: Accumulate, so the stats are the totals of all the components of the world
+    CSV_CUSTOM_STAT( MissionSystem, MissionsStarted, static_cast< int32 >( RuntimeCounters.MissionsStarted ), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, MissionsFinished, static_cast< int32 >( RuntimeCounters.MissionsFinished ), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, ObjectivesStarted, static_cast< int32 >( RuntimeCounters.ObjectivesStarted ), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, ObjectivesFinished, static_cast< int32 >( RuntimeCounters.ObjectivesFinished ), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, ActionsStarted, static_cast< int32 >( RuntimeCounters.ActionsStarted ), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, ActionsFinished, static_cast< int32 >( RuntimeCounters.ActionsFinished ), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, ActiveMissions, ActiveMissions.Num(), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, MissionStartObservers, MissionStartObservers.Num(), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, MissionEndObservers, MissionEndObservers.Num(), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, ObjectiveStartObservers, MissionObjectiveStartObservers.Num(), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, ObjectiveEndObservers, MissionObjectiveEndObservers.Num(), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, HistoryMissions, MissionHistory.GetMissionStates().GetStateCount(), ECsvCustomStatOp::Accumulate );
+    CSV_CUSTOM_STAT( MissionSystem, HistoryObjectives, MissionHistory.GetObjectiveStates().GetStateCount(), ECsvCustomStatOp::Accumulate );
+
     if ( ViewModel != nullptr )
     {
-        ViewModel->SetMissionObjectiveEnded( mission, objective );
+        CSV_CUSTOM_STAT( MissionSystem, MissionViewModels, ViewModel->GetMissionViewModelCount(), ECsvCustomStatOp::Accumulate );
+        CSV_CUSTOM_STAT( MissionSystem, ObjectiveViewModels, ViewModel->GetObjectiveViewModelCount(), ECsvCustomStatOp::Accumulate );
     }
+#endif
 }
\ No newline at end of file
@@ -4,10 +4,15 @@
 #include "MSMission.h"
 #include "MSMissionAction.h"
 #include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSProfiling.h"
 
-void FMSActionExecutor::Initialize( UObject * action_owner, const TArray< UMSMissionAction * > & action_classes, const TFunction< void() > callback )
+void FMSActionExecutor::Initialize( UObject * action_owner, const TArray< UMSMissionAction * > & action_templates, const TFunction< void() > callback )
 {
+    Release();
+
     Outer = action_owner;
+    Component = action_owner != nullptr ? action_owner->GetTypedOuter< UMSMissionSystemComponent >() : nullptr;
     Callback = callback;
 
     FString owning_object_name;
@@ -23,16 +28,28 @@ void FMSActionExecutor::Initialize( UObject * action_owner, const TArray< UMSMis
         owning_object_name = action_owner->GetName();
     }
 
-    InstancedActions = action_classes;
+    // The templates of the mission data are shared by all the missions created from the same data, so each executor works on its own copies.
+    // The actions of an objective are instanced with the objective, so they are executed as is
+    InstancedActions.Reset( action_templates.Num() );
 
-    for ( auto * action : InstancedActions )
+    for ( auto * action_template : action_templates )
     {
+        auto * action = action_template->GetOuter() == action_owner
+                            ? action_template
+                            : Component.IsValid()
+                                ? Component->AcquireAction( action_template )
+                                : DuplicateObject< UMSMissionAction >( action_template, action_owner );
+
         action->Initialize( action_owner );
+        InstancedActions.Add( action );
     }
 }
 
-void FMSActionExecutor::Execute()
+void FMSActionExecutor::Execute( const bool hold_barrier_actions )
 {
+    SCOPE_CYCLE_COUNTER( STAT_MissionSystem_ExecuteActions );
+    MS_TRACE_SCOPE( "ExecuteActions" );
+
     if ( InstancedActions.Num() == 0 )
     {
         TryExecuteCallback();
@@ -43,18 +60,118 @@ void FMSActionExecutor::Execute()
 
     for ( auto index = PendingActions.Num() - 1; index >= 0; index-- )
     {
+        // Actions which finish immediately can end the owner of the executor, which releases the pending actions
+        if ( !PendingActions.IsValidIndex( index ) )
+        {
+            continue;
+        }
+
         auto * action = PendingActions[ index ];
 
-        action->OnMissionActionComplete().AddRaw( this, &FMSActionExecutor::OnActionExecuted );
+        if ( hold_barrier_actions && action->IsPipelineBarrier() )
+        {
+            HeldBarrierActions.Add( action );
+            continue;
+        }
+
+        ExecuteAction( action );
+    }
+}
+
+void FMSActionExecutor::ExecuteBarrierActions()
+{
+    // :NOTE: Move the held actions out, as the actions which finish immediately can end the owner of the executor, which releases the pending actions
+    const auto held_actions = MoveTemp( HeldBarrierActions );
+    HeldBarrierActions.Reset();
+
+    for ( auto * action : held_actions )
+    {
+        if ( PendingActions.Contains( action ) )
+        {
+            ExecuteAction( action );
+        }
+    }
+}
+
+void FMSActionExecutor::ExecuteAction( UMSMissionAction * action )
+{
+    action->OnMissionActionComplete().AddRaw( this, &FMSActionExecutor::OnActionExecuted );
+
+    // In time sliced mode, the action is executed when the component processes the transition
+    if ( auto * component = Component.Get(); component != nullptr && component->IsTimeSlicingTransitions() )
+    {
+        component->ScheduleTransition( FMSMissionTransition::MakeExecuteAction( action ) );
+        return;
+    }
+
+    UE_LOG( LogMissionSystem, Verbose, TEXT( "Execute action %s" ), *GetNameSafe( action ) );
 
-        UE_LOG( LogMissionSystem, Verbose, TEXT( "Execute action %s" ), *GetNameSafe( action ) );
+    MS_TRACE_NAMED_SCOPE( "ExecuteAction", FMSTrace::GetActionName( action ) );
+    MS_TRACE_EVENT( ActionExecuted, action );
 
-        action->Execute();
+    if ( auto * component = Component.Get() )
+    {
+        component->RecordActionStarted( *action );
+    }
+
+    action->Execute();
+}
+
+void FMSActionExecutor::Release()
+{
+    for ( auto * action : PendingActions )
+    {
+        action->OnMissionActionComplete().RemoveAll( this );
+    }
+
+    if ( auto * component = Component.Get() )
+    {
+        for ( const auto * action : PendingActions )
+        {
+            component->RecordActionCancelled( *action );
+        }
+
+        for ( auto * action : InstancedActions )
+        {
+            // :NOTE: The actions which are still executing can call FinishExecute later, which would complete the action once it is reused. They are left to the garbage collector
+            if ( PendingActions.Contains( action ) && !HeldBarrierActions.Contains( action ) )
+            {
+                continue;
+            }
+
+            // The actions instanced in the owner are reused with it
+            if ( action->GetOuter() == Outer.Get() )
+            {
+                continue;
+            }
+
+            component->ReleaseAction( action );
+        }
     }
+
+    InstancedActions.Reset();
+    PendingActions.Reset();
+    HeldBarrierActions.Reset();
+}
+
+void FMSActionExecutor::Reset()
+{
+    Release();
+
+    Outer.Reset();
+    Component.Reset();
+    Callback = nullptr;
 }
 
 void FMSActionExecutor::OnActionExecuted( UMSMissionAction * action )
 {
+    MS_TRACE_EVENT( ActionFinished, action );
+
+    if ( auto * component = Component.Get() )
+    {
+        component->RecordActionFinished( *action );
+    }
+
     action->OnMissionActionComplete().RemoveAll( this );
     ensureAlways( PendingActions.Remove( action ) > 0 );
     TryExecuteCallback();
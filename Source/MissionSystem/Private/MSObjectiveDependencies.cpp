@@ -0,0 +1,166 @@
+#include "MSObjectiveDependencies.h"
+
+#include "MSMissionData.h"
+
+bool FMSObjectiveDependencies::Build( const TConstArrayView< FMSMissionObjectiveData > objectives )
+{
+    TArray< TArray< int32 > > dependencies;
+
+    GatherDependencies( objectives, true, dependencies );
+
+    if ( Sort( dependencies ) )
+    {
+        return true;
+    }
+
+    // The list order has no cycle
+    GatherDependencies( objectives, false, dependencies );
+    verify( Sort( dependencies ) );
+
+    return false;
+}
+
+void FMSObjectiveDependencies::GatherDependencies( const TConstArrayView< FMSMissionObjectiveData > objectives, const bool use_prerequisites, TArray< TArray< int32 > > & dependencies )
+{
+    dependencies.Reset();
+    dependencies.SetNum( objectives.Num() );
+
+    TMap< FSoftObjectPath, int32 > objective_indices;
+    objective_indices.Reserve( objectives.Num() );
+
+    for ( auto index = 0; index < objectives.Num(); ++index )
+    {
+        if ( !objectives[ index ].Objective.IsNull() )
+        {
+            objective_indices.FindOrAdd( objectives[ index ].Objective.ToSoftObjectPath(), index );
+        }
+    }
+
+    // An objective which is a prerequisite of an objective earlier in the list does not wait for the previous group,
+    // which can contain that earlier objective, or objectives which wait for it
+    TBitArray<> is_forward_prerequisite( false, objectives.Num() );
+
+    if ( use_prerequisites )
+    {
+        for ( auto index = 0; index < objectives.Num(); ++index )
+        {
+            if ( !objectives[ index ].bEnabled )
+            {
+                continue;
+            }
+
+            for ( const auto & prerequisite : objectives[ index ].Prerequisites )
+            {
+                if ( const auto * prerequisite_index = objective_indices.Find( prerequisite.ToSoftObjectPath() ); prerequisite_index != nullptr && *prerequisite_index > index )
+                {
+                    is_forward_prerequisite[ *prerequisite_index ] = true;
+                }
+            }
+        }
+    }
+
+    TArray< int32 > previous_group;
+    TArray< int32 > current_group;
+
+    for ( auto index = 0; index < objectives.Num(); ++index )
+    {
+        const auto & objective_data = objectives[ index ];
+
+        // Disabled objectives are not part of any group. The objectives which depend on them do not wait for them
+        if ( !objective_data.bEnabled )
+        {
+            continue;
+        }
+
+        if ( !objective_data.bStartWithPreviousObjective )
+        {
+            previous_group = MoveTemp( current_group );
+            current_group.Reset();
+        }
+
+        current_group.Add( index );
+
+        if ( !use_prerequisites || objective_data.Prerequisites.Num() == 0 )
+        {
+            if ( !is_forward_prerequisite[ index ] )
+            {
+                dependencies[ index ].Append( previous_group );
+            }
+
+            continue;
+        }
+
+        for ( const auto & prerequisite : objective_data.Prerequisites )
+        {
+            const auto * prerequisite_index = objective_indices.Find( prerequisite.ToSoftObjectPath() );
+
+            // Unknown prerequisites are reported by the data validation of the mission data
+            if ( prerequisite_index != nullptr && *prerequisite_index != index )
+            {
+                dependencies[ index ].AddUnique( *prerequisite_index );
+            }
+        }
+    }
+}
+
+bool FMSObjectiveDependencies::Sort( const TArray< TArray< int32 > > & dependencies )
+{
+    const auto objective_count = dependencies.Num();
+
+    DependencyCounts.Reset( objective_count );
+    FirstDependents.Reset( objective_count + 1 );
+    FirstDependents.SetNumZeroed( objective_count + 1 );
+
+    for ( auto index = 0; index < objective_count; ++index )
+    {
+        DependencyCounts.Add( dependencies[ index ].Num() );
+
+        for ( const auto prerequisite_index : dependencies[ index ] )
+        {
+            ++FirstDependents[ prerequisite_index + 1 ];
+        }
+    }
+
+    for ( auto index = 0; index < objective_count; ++index )
+    {
+        FirstDependents[ index + 1 ] += FirstDependents[ index ];
+    }
+
+    Dependents.SetNumUninitialized( FirstDependents[ objective_count ] );
+
+    auto next_dependents = FirstDependents;
+
+    for ( auto index = 0; index < objective_count; ++index )
+    {
+        for ( const auto prerequisite_index : dependencies[ index ] )
+        {
+            Dependents[ next_dependents[ prerequisite_index ]++ ] = index;
+        }
+    }
+
+    // Kahn's algorithm. The objectives which are ready at the same time stay in the order of the list
+    auto remaining_counts = DependencyCounts;
+
+    TopologicalOrder.Reset( objective_count );
+
+    for ( auto index = 0; index < objective_count; ++index )
+    {
+        if ( remaining_counts[ index ] == 0 )
+        {
+            TopologicalOrder.Add( index );
+        }
+    }
+
+    for ( auto order_index = 0; order_index < TopologicalOrder.Num(); ++order_index )
+    {
+        for ( const auto dependent_index : GetDependents( TopologicalOrder[ order_index ] ) )
+        {
+            if ( --remaining_counts[ dependent_index ] == 0 )
+            {
+                TopologicalOrder.Add( dependent_index );
+            }
+        }
+    }
+
+    return TopologicalOrder.Num() == objective_count;
+}
@@ -0,0 +1,72 @@
+#include "MSObjectivePool.h"
+
+#include "MSMissionObjective.h"
+
+namespace
+{
+    constexpr ERenameFlags PoolRenameFlags = REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional;
+}
+
+FMSObjectivePool::FMSObjectivePool() :
+    HitCount( 0 ),
+    MissCount( 0 ),
+    PooledObjectiveCount( 0 )
+{
+}
+
+UMSMissionObjective * FMSObjectivePool::Acquire( UObject * outer, const TSubclassOf< UMSMissionObjective > & objective_class )
+{
+    if ( auto * pooled_objectives = PooledObjectives.Find( objective_class.Get() ) )
+    {
+        while ( pooled_objectives->Objectives.Num() > 0 )
+        {
+            auto * objective = pooled_objectives->Objectives.Pop().Get();
+            --PooledObjectiveCount;
+
+            if ( IsValid( objective ) )
+            {
+                if ( objective->GetOuter() != outer )
+                {
+                    objective->Rename( nullptr, outer, PoolRenameFlags );
+                }
+
+                ++HitCount;
+                return objective;
+            }
+        }
+    }
+
+    ++MissCount;
+    return NewObject< UMSMissionObjective >( outer, objective_class );
+}
+
+void FMSObjectivePool::Release( UMSMissionObjective * objective, UObject * pool_outer, const int32 max_objectives_per_class )
+{
+    if ( !IsValid( objective ) )
+    {
+        return;
+    }
+
+    auto & pooled_objectives = PooledObjectives.FindOrAdd( objective->GetClass() );
+
+    if ( pooled_objectives.Objectives.Num() >= max_objectives_per_class )
+    {
+        return;
+    }
+
+    objective->ResetObjective();
+
+    if ( objective->GetOuter() != pool_outer )
+    {
+        objective->Rename( nullptr, pool_outer, PoolRenameFlags );
+    }
+
+    pooled_objectives.Objectives.Add( objective );
+    ++PooledObjectiveCount;
+}
+
+void FMSObjectivePool::Reset()
+{
+    PooledObjectives.Reset();
+    PooledObjectiveCount = 0;
+}
@@ -0,0 +1,134 @@
+#include "MSObjectiveTagMatcher.h"
+
+void FMSObjectiveTagMatcher::Build( const TConstArrayView< FString > tokens )
+{
+    Reset();
+
+    if ( tokens.Num() == 0 )
+    {
+        return;
+    }
+
+    Nodes.AddDefaulted();
+
+    for ( const auto & token : tokens )
+    {
+        AddToken( token );
+    }
+}
+
+void FMSObjectiveTagMatcher::Reset()
+{
+    Nodes.Reset();
+    CachedMatches.Reset();
+}
+
+bool FMSObjectiveTagMatcher::Matches( const FGameplayTagContainer & tags ) const
+{
+    if ( IsEmpty() )
+    {
+        return false;
+    }
+
+    for ( const auto & tag : tags )
+    {
+        if ( MatchesTagName( tag.GetTagName() ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FMSObjectiveTagMatcher::MatchesTagName( const FName tag_name ) const
+{
+    if ( IsEmpty() )
+    {
+        return false;
+    }
+
+    if ( const auto * is_match = CachedMatches.Find( tag_name ) )
+    {
+        return *is_match;
+    }
+
+    TStringBuilder< 256 > tag_string;
+    tag_name.AppendString( tag_string );
+
+    const auto is_match = ContainsToken( tag_string.ToView() );
+    CachedMatches.Add( tag_name, is_match );
+
+    return is_match;
+}
+
+void FMSObjectiveTagMatcher::AddToken( const FString & token )
+{
+    auto node_index = 0;
+
+    for ( const auto character : token )
+    {
+        const auto lower_character = FChar::ToLower( character );
+        auto child_index = FindChild( node_index, lower_character );
+
+        if ( child_index == INDEX_NONE )
+        {
+            child_index = Nodes.Num();
+
+            FNode child;
+            child.Character = lower_character;
+            child.NextSibling = Nodes[ node_index ].FirstChild;
+
+            Nodes.Add( child );
+            Nodes[ node_index ].FirstChild = child_index;
+        }
+
+        node_index = child_index;
+    }
+
+    Nodes[ node_index ].bIsTokenEnd = true;
+}
+
+int32 FMSObjectiveTagMatcher::FindChild( const int32 node_index, const TCHAR character ) const
+{
+    for ( auto child_index = Nodes[ node_index ].FirstChild; child_index != INDEX_NONE; child_index = Nodes[ child_index ].NextSibling )
+    {
+        if ( Nodes[ child_index ].Character == character )
+        {
+            return child_index;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+bool FMSObjectiveTagMatcher::ContainsToken( const FStringView text ) const
+{
+    // An empty token is contained in any name
+    if ( Nodes[ 0 ].bIsTokenEnd )
+    {
+        return true;
+    }
+
+    for ( auto start_index = 0; start_index < text.Len(); ++start_index )
+    {
+        auto node_index = 0;
+
+        for ( auto index = start_index; index < text.Len(); ++index )
+        {
+            node_index = FindChild( node_index, FChar::ToLower( text[ index ] ) );
+
+            if ( node_index == INDEX_NONE )
+            {
+                break;
+            }
+
+            if ( Nodes[ node_index ].bIsTokenEnd )
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,167 @@
+#include "MSProfiling.h"
+
+#include "MSMissionAction.h"
+
+DEFINE_STAT( STAT_MissionSystem_ProcessTransition );
+DEFINE_STAT( STAT_MissionSystem_StartMission );
+DEFINE_STAT( STAT_MissionSystem_EndMission );
+DEFINE_STAT( STAT_MissionSystem_ExecuteObjective );
+DEFINE_STAT( STAT_MissionSystem_ExecuteActions );
+DEFINE_STAT( STAT_MissionSystem_DispatchEvent );
+DEFINE_STAT( STAT_MissionSystem_FlushEvents );
+DEFINE_STAT( STAT_MissionSystem_SaveHistory );
+
+#if MS_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE( MissionSystemChannel )
+
+UE_TRACE_EVENT_BEGIN( MissionSystem, MissionStarted )
+    UE_TRACE_EVENT_FIELD( uint64, Cycle )
+    UE_TRACE_EVENT_FIELD( UE::Trace::WideString, Name )
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN( MissionSystem, MissionEnded )
+    UE_TRACE_EVENT_FIELD( uint64, Cycle )
+    UE_TRACE_EVENT_FIELD( bool, WasCancelled )
+    UE_TRACE_EVENT_FIELD( UE::Trace::WideString, Name )
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN( MissionSystem, ObjectiveStarted )
+    UE_TRACE_EVENT_FIELD( uint64, Cycle )
+    UE_TRACE_EVENT_FIELD( UE::Trace::WideString, Name )
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN( MissionSystem, ObjectiveEnded )
+    UE_TRACE_EVENT_FIELD( uint64, Cycle )
+    UE_TRACE_EVENT_FIELD( bool, WasCancelled )
+    UE_TRACE_EVENT_FIELD( UE::Trace::WideString, Name )
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN( MissionSystem, ActionExecuted )
+    UE_TRACE_EVENT_FIELD( uint64, Cycle )
+    UE_TRACE_EVENT_FIELD( UE::Trace::WideString, Name )
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN( MissionSystem, ActionFinished )
+    UE_TRACE_EVENT_FIELD( uint64, Cycle )
+    UE_TRACE_EVENT_FIELD( UE::Trace::WideString, Name )
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN( MissionSystem, ActionPastDeadline )
+    UE_TRACE_EVENT_FIELD( uint64, Cycle )
+    UE_TRACE_EVENT_FIELD( double, Latency )
+    UE_TRACE_EVENT_FIELD( UE::Trace::WideString, Name )
+UE_TRACE_EVENT_END()
+
+FString FMSTrace::GetObjectName( const UObject * object )
+{
+    return GetNameSafe( object );
+}
+
+FString FMSTrace::GetActionName( const UMSMissionAction * action )
+{
+    return action != nullptr ? action->GetDescription() : GetObjectName( action );
+}
+
+void FMSTrace::OutputMissionStarted( const UObject * mission_data )
+{
+    if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) )
+    {
+        return;
+    }
+
+    const auto name = GetObjectName( mission_data );
+
+    UE_TRACE_LOG( MissionSystem, MissionStarted, MissionSystemChannel )
+        << MissionStarted.Cycle( FPlatformTime::Cycles64() )
+        << MissionStarted.Name( *name, name.Len() );
+}
+
+void FMSTrace::OutputMissionEnded( const UObject * mission_data, const bool was_cancelled )
+{
+    if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) )
+    {
+        return;
+    }
+
+    const auto name = GetObjectName( mission_data );
+
+    UE_TRACE_LOG( MissionSystem, MissionEnded, MissionSystemChannel )
+        << MissionEnded.Cycle( FPlatformTime::Cycles64() )
+        << MissionEnded.WasCancelled( was_cancelled )
+        << MissionEnded.Name( *name, name.Len() );
+}
+
+void FMSTrace::OutputObjectiveStarted( const UClass * objective_class )
+{
+    if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) )
+    {
+        return;
+    }
+
+    const auto name = GetObjectName( objective_class );
+
+    UE_TRACE_LOG( MissionSystem, ObjectiveStarted, MissionSystemChannel )
+        << ObjectiveStarted.Cycle( FPlatformTime::Cycles64() )
+        << ObjectiveStarted.Name( *name, name.Len() );
+}
+
+void FMSTrace::OutputObjectiveEnded( const UClass * objective_class, const bool was_cancelled )
+{
+    if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) )
+    {
+        return;
+    }
+
+    const auto name = GetObjectName( objective_class );
+
+    UE_TRACE_LOG( MissionSystem, ObjectiveEnded, MissionSystemChannel )
+        << ObjectiveEnded.Cycle( FPlatformTime::Cycles64() )
+        << ObjectiveEnded.WasCancelled( was_cancelled )
+        << ObjectiveEnded.Name( *name, name.Len() );
+}
+
+void FMSTrace::OutputActionExecuted( const UMSMissionAction * action )
+{
+    if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) )
+    {
+        return;
+    }
+
+    const auto name = GetActionName( action );
+
+    UE_TRACE_LOG( MissionSystem, ActionExecuted, MissionSystemChannel )
+        << ActionExecuted.Cycle( FPlatformTime::Cycles64() )
+        << ActionExecuted.Name( *name, name.Len() );
+}
+
+void FMSTrace::OutputActionFinished( const UMSMissionAction * action )
+{
+    if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) )
+    {
+        return;
+    }
+
+    const auto name = GetActionName( action );
+
+    UE_TRACE_LOG( MissionSystem, ActionFinished, MissionSystemChannel )
+        << ActionFinished.Cycle( FPlatformTime::Cycles64() )
+        << ActionFinished.Name( *name, name.Len() );
+}
+
+void FMSTrace::OutputActionPastDeadline( const UMSMissionAction * action, const double latency )
+{
+    if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) )
+    {
+        return;
+    }
+
+    const auto name = GetActionName( action );
+
+    UE_TRACE_LOG( MissionSystem, ActionPastDeadline, MissionSystemChannel )
+        << ActionPastDeadline.Cycle( FPlatformTime::Cycles64() )
+        << ActionPastDeadline.Latency( latency )
+        << ActionPastDeadline.Name( *name, name.Len() );
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include "MSReplicatedMissionState.h"
+
+#include "MSMissionHistory.h"
+#include "MSMissionSystemComponent.h"
+
+namespace
+{
+    constexpr uint32 ObjectiveFlag = 1 << 0;
+    constexpr uint32 InGraphFlag = 1 << 1;
+    constexpr uint32 StateShift = 2;
+    constexpr uint32 FlagBitCount = 4;
+}
+
+FMSReplicatedMissionStateItem::FMSReplicatedMissionStateItem() :
+    Index( INDEX_NONE ),
+    bIsObjective( false ),
+    bIsInGraph( false ),
+    State( EMSState::Active )
+{
+}
+
+bool FMSReplicatedMissionStateItem::NetSerialize( FArchive & archive, UPackageMap * /*package_map*/, bool & out_success )
+{
+    // Kind, graph membership and state fit in 4 bits, followed by the packed index, and the GUID for the entries outside of the graph
+    uint32 flags = ( bIsObjective ? ObjectiveFlag : 0 ) | ( bIsInGraph ? InGraphFlag : 0 ) | ( static_cast< uint32 >( State ) << StateShift );
+    archive.SerializeBits( &flags, FlagBitCount );
+
+    auto index = static_cast< uint32 >( Index );
+    archive.SerializeIntPacked( index );
+
+    if ( archive.IsLoading() )
+    {
+        bIsObjective = ( flags & ObjectiveFlag ) != 0;
+        bIsInGraph = ( flags & InGraphFlag ) != 0;
+        State = static_cast< EMSState >( FMath::Min( flags >> StateShift, static_cast< uint32 >( EMSState::Complete ) ) );
+        Index = static_cast< int32 >( index );
+    }
+
+    if ( !bIsInGraph )
+    {
+        archive << Id;
+    }
+
+    out_success = !archive.IsError();
+    return true;
+}
+
+void FMSReplicatedMissionStateItem::PreReplicatedRemove( const FMSReplicatedMissionState & array_serializer )
+{
+    if ( auto * owner = array_serializer.GetOwner() )
+    {
+        owner->OnReplicatedStateRemoved( *this );
+    }
+}
+
+void FMSReplicatedMissionStateItem::PostReplicatedAdd( const FMSReplicatedMissionState & array_serializer )
+{
+    if ( auto * owner = array_serializer.GetOwner() )
+    {
+        owner->OnReplicatedStateChanged( *this );
+    }
+}
+
+void FMSReplicatedMissionStateItem::PostReplicatedChange( const FMSReplicatedMissionState & array_serializer )
+{
+    if ( auto * owner = array_serializer.GetOwner() )
+    {
+        owner->OnReplicatedStateChanged( *this );
+    }
+}
+
+FMSReplicatedMissionState::FMSReplicatedMissionState() :
+    Owner( nullptr )
+{
+}
+
+void FMSReplicatedMissionState::UpdateMission( const FMSMissionHistory & history, const int32 mission_index )
+{
+    UpdateItem( history.GetMissionStates(), mission_index, false, history.GetGraphMissionCount() );
+}
+
+void FMSReplicatedMissionState::UpdateObjective( const FMSMissionHistory & history, const int32 objective_index )
+{
+    UpdateItem( history.GetObjectiveStates(), objective_index, true, history.GetGraphObjectiveCount() );
+}
+
+void FMSReplicatedMissionState::Rebuild( const FMSMissionHistory & history )
+{
+    Items.Reset();
+    MissionItemIndices.Reset();
+    ObjectiveItemIndices.Reset();
+
+    const auto & mission_states = history.GetMissionStates();
+    for ( auto index = 0; index < mission_states.Num(); ++index )
+    {
+        if ( mission_states.GetState( index ).IsSet() )
+        {
+            UpdateMission( history, index );
+        }
+    }
+
+    const auto & objective_states = history.GetObjectiveStates();
+    for ( auto index = 0; index < objective_states.Num(); ++index )
+    {
+        if ( objective_states.GetState( index ).IsSet() )
+        {
+            UpdateObjective( history, index );
+        }
+    }
+
+    MarkArrayDirty();
+}
+
+void FMSReplicatedMissionState::UpdateItem( const FMSMissionStateTable & table, const int32 index, const bool is_objective, const int32 graph_count )
+{
+    const auto state = table.GetState( index );
+
+    if ( !ensureAlways( state.IsSet() ) )
+    {
+        return;
+    }
+
+    auto & item_indices = is_objective ? ObjectiveItemIndices : MissionItemIndices;
+
+    if ( item_indices.Num() <= index )
+    {
+        const auto previous_count = item_indices.Num();
+        item_indices.SetNumUninitialized( index + 1 );
+
+        for ( auto item_index = previous_count; item_index < item_indices.Num(); ++item_index )
+        {
+            item_indices[ item_index ] = INDEX_NONE;
+        }
+    }
+
+    auto & item_index = item_indices[ index ];
+
+    if ( item_index == INDEX_NONE )
+    {
+        item_index = Items.AddDefaulted();
+
+        auto & new_item = Items[ item_index ];
+        new_item.Index = index;
+        new_item.bIsObjective = is_objective;
+        new_item.bIsInGraph = index < graph_count;
+        new_item.Id = table.HasId( index ) ? table.GetId( index ) : FGuid();
+    }
+    else if ( Items[ item_index ].State == state.GetValue() )
+    {
+        return;
+    }
+
+    auto & item = Items[ item_index ];
+    item.State = state.GetValue();
+    MarkItemDirty( item );
+}
@@ -3,30 +3,101 @@
 #include "MSMission.h"
 #include "MSMissionData.h"
 #include "ViewModels/MSObjectiveViewModel.h"
+#include "ViewModels/MSViewModel.h"
+
+UMSMissionViewModel::UMSMissionViewModel() :
+    bIsDirty( false )
+{
+}
 
 void UMSMissionViewModel::Initialize( UMSMission * mission )
 {
     check( mission != nullptr );
 
     Mission = mission;
-    Name = Mission->GetMissionData()->Name;
+
+    UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED( GetName );
 }
 
-void UMSMissionViewModel::SetObjectiveStarted( const TSubclassOf< UMSMissionObjective > & objective )
+void UMSMissionViewModel::Reset()
 {
-    auto * objective_vm = NewObject< UMSObjectiveViewModel >( this );
+    auto * root_vm = CastChecked< UMSViewModel >( GetOuter() );
+
+    for ( const auto & objective_vm : ActiveObjectives )
+    {
+        root_vm->ReleaseObjectiveViewModel( objective_vm );
+    }
+
+    ActiveObjectives.Reset();
+    ObjectiveViewModels.Reset();
+    Mission = nullptr;
+    bIsDirty = false;
+}
+
+bool UMSMissionViewModel::SetObjectiveStarted( const TSubclassOf< UMSMissionObjective > & objective )
+{
+    auto & objective_vm = ObjectiveViewModels.FindOrAdd( objective.Get() );
+
+    if ( objective_vm != nullptr )
+    {
+        return false;
+    }
+
+    objective_vm = CastChecked< UMSViewModel >( GetOuter() )->AcquireObjectiveViewModel();
     objective_vm->Initialize( objective );
 
-    ActiveObjectives.Add( objective_vm );
+    const auto index = ActiveObjectives.Add( objective_vm );
+    bIsDirty = true;
 
-    UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED( ActiveObjectives );
+    OnObjectiveAdded.Broadcast( objective_vm, index );
+
+    return true;
 }
 
-void UMSMissionViewModel::SetObjectiveEnded( const TSubclassOf< UMSMissionObjective > & objective )
+bool UMSMissionViewModel::SetObjectiveEnded( const TSubclassOf< UMSMissionObjective > & objective )
 {
-    ActiveObjectives.RemoveAll( [ & ]( auto objective_vm ) {
-        return objective_vm->GetObjectiveClass() == objective;
-    } );
+    TObjectPtr< UMSObjectiveViewModel > objective_vm;
+
+    if ( !ObjectiveViewModels.RemoveAndCopyValue( objective.Get(), objective_vm ) )
+    {
+        return false;
+    }
+
+    const auto index = ActiveObjectives.IndexOfByKey( objective_vm );
+
+    if ( !ensureAlways( index != INDEX_NONE ) )
+    {
+        return false;
+    }
+
+    ActiveObjectives.RemoveAt( index );
+    bIsDirty = true;
+
+    OnObjectiveRemoved.Broadcast( objective_vm, index );
+
+    CastChecked< UMSViewModel >( GetOuter() )->ReleaseObjectiveViewModel( objective_vm );
+
+    return true;
+}
+
+void UMSMissionViewModel::FlushChanges()
+{
+    if ( !bIsDirty )
+    {
+        return;
+    }
+
+    bIsDirty = false;
 
     UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED( ActiveObjectives );
-}
\ No newline at end of file
+}
+
+FText UMSMissionViewModel::GetName() const
+{
+    if ( Mission == nullptr || Mission->GetMissionData() == nullptr )
+    {
+        return FText::GetEmpty();
+    }
+
+    return Mission->GetMissionData()->Name;
+}
@@ -6,5 +6,20 @@ void UMSObjectiveViewModel::Initialize( const TSubclassOf< UMSMissionObjective >
 {
     ObjectiveClass = objective_class;
 
-    Name = ObjectiveClass.GetDefaultObject()->GetDescription();
-}
\ No newline at end of file
+    UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED( GetName );
+}
+
+void UMSObjectiveViewModel::Reset()
+{
+    ObjectiveClass = nullptr;
+}
+
+FText UMSObjectiveViewModel::GetName() const
+{
+    if ( ObjectiveClass == nullptr )
+    {
+        return FText::GetEmpty();
+    }
+
+    return ObjectiveClass.GetDefaultObject()->GetDescription();
+}
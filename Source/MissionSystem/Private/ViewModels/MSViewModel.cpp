@@ -1,35 +1,101 @@
 #include "ViewModels/MSViewModel.h"
 
+#include "MSMission.h"
 #include "ViewModels/MSMissionViewModel.h"
+#include "ViewModels/MSObjectiveViewModel.h"
+
+#include <Misc/CoreDelegates.h>
+
+UMSViewModel::UMSViewModel() :
+    MissionViewModelCount( 0 ),
+    ObjectiveViewModelCount( 0 ),
+    bAreActiveMissionsDirty( false ),
+    bAreViewModelsCreated( true ),
+    bAreViewModelsRequested( false )
+{
+}
+
+void UMSViewModel::BeginDestroy()
+{
+    FCoreDelegates::OnEndFrame.Remove( EndFrameDelegateHandle );
+    EndFrameDelegateHandle.Reset();
+
+    Super::BeginDestroy();
+}
+
+void UMSViewModel::Initialize( const bool create_view_models_lazily )
+{
+    bAreViewModelsCreated = !create_view_models_lazily;
+
+    // Until the view models are created, each end of frame checks whether they were requested
+    if ( create_view_models_lazily )
+    {
+        MarkDirty( nullptr );
+    }
+}
 
 void UMSViewModel::SetMissionStarted( UMSMission * mission )
 {
-    if ( GetMissionViewModel( mission ) != nullptr )
+    if ( Missions.Contains( mission ) )
     {
         return;
     }
 
-    auto * mission_vm = NewObject< UMSMissionViewModel >( this );
-    mission_vm->Initialize( mission );
-    ActiveMissions.Add( mission_vm );
+    Missions.Add( mission );
+    bAreActiveMissionsDirty = true;
+    MarkDirty( nullptr );
+
+    if ( !bAreViewModelsCreated )
+    {
+        return;
+    }
+
+    auto * mission_vm = AddMissionViewModel( mission );
 
-    UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED( ActiveMissions );
+    OnMissionAdded.Broadcast( mission_vm, ActiveMissions.Num() - 1 );
 }
 
 void UMSViewModel::SetMissionEnded( UMSMission * mission )
 {
-    ActiveMissions.RemoveAll( [ & ]( auto mission_vm ) {
-        return mission_vm->GetMission() == mission;
-    } );
+    if ( Missions.Remove( mission ) == 0 )
+    {
+        return;
+    }
 
-    UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED( ActiveMissions );
+    bAreActiveMissionsDirty = true;
+    MarkDirty( nullptr );
+
+    TObjectPtr< UMSMissionViewModel > mission_vm;
+
+    if ( !MissionViewModels.RemoveAndCopyValue( mission, mission_vm ) )
+    {
+        return;
+    }
+
+    const auto index = ActiveMissions.IndexOfByKey( mission_vm );
+
+    if ( !ensureAlways( index != INDEX_NONE ) )
+    {
+        return;
+    }
+
+    ActiveMissions.RemoveAt( index );
+    DirtyMissionViewModels.Remove( mission_vm );
+
+    OnMissionRemoved.Broadcast( mission_vm, index );
+
+    mission_vm->Reset();
+    MissionViewModelPool.Add( mission_vm );
 }
 
 void UMSViewModel::SetMissionObjectiveStarted( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective )
 {
     if ( auto * mission_vm = GetMissionViewModel( mission ) )
     {
-        mission_vm->SetObjectiveStarted( objective );
+        if ( mission_vm->SetObjectiveStarted( objective ) )
+        {
+            MarkDirty( mission_vm );
+        }
     }
 }
 
@@ -37,18 +103,133 @@ void UMSViewModel::SetMissionObjectiveEnded( UMSMission * mission, const TSubcla
 {
     if ( auto * mission_vm = GetMissionViewModel( mission ) )
     {
-        mission_vm->SetObjectiveEnded( objective );
+        if ( mission_vm->SetObjectiveEnded( objective ) )
+        {
+            MarkDirty( mission_vm );
+        }
+    }
+}
+
+void UMSViewModel::FlushChanges()
+{
+    if ( !bAreViewModelsCreated )
+    {
+        if ( !bAreViewModelsRequested )
+        {
+            return;
+        }
+
+        CreateViewModels();
+        bAreActiveMissionsDirty = true;
+    }
+
+    FCoreDelegates::OnEndFrame.Remove( EndFrameDelegateHandle );
+    EndFrameDelegateHandle.Reset();
+
+    // :NOTE: Move the dirty view models out, as the bound widgets can trigger new changes while they are notified
+    const auto dirty_mission_vms = MoveTemp( DirtyMissionViewModels );
+
+    for ( const auto & mission_vm : dirty_mission_vms )
+    {
+        mission_vm->FlushChanges();
     }
+
+    if ( bAreActiveMissionsDirty )
+    {
+        bAreActiveMissionsDirty = false;
+
+        UE_MVVM_BROADCAST_FIELD_VALUE_CHANGED( GetActiveMissions );
+    }
+}
+
+UMSObjectiveViewModel * UMSViewModel::AcquireObjectiveViewModel()
+{
+    if ( ObjectiveViewModelPool.Num() > 0 )
+    {
+        return ObjectiveViewModelPool.Pop();
+    }
+
+    ++ObjectiveViewModelCount;
+    return NewObject< UMSObjectiveViewModel >( this );
+}
+
+void UMSViewModel::ReleaseObjectiveViewModel( UMSObjectiveViewModel * objective_vm )
+{
+    objective_vm->Reset();
+    ObjectiveViewModelPool.Add( objective_vm );
+}
+
+TArray< UMSMissionViewModel * > UMSViewModel::GetActiveMissions() const
+{
+    // :NOTE: The view models created lazily are notified once they are created, at the end of the frame
+    if ( !bAreViewModelsCreated )
+    {
+        bAreViewModelsRequested = true;
+    }
+
+    return ActiveMissions;
 }
 
 UMSMissionViewModel * UMSViewModel::GetMissionViewModel( UMSMission * mission ) const
 {
-    if ( auto * vm_ptr = ActiveMissions.FindByPredicate( [ & ]( auto mission_vm ) {
-             return mission_vm->GetMission() == mission;
-         } ) )
+    if ( const auto * mission_vm = MissionViewModels.Find( mission ) )
     {
-        return *vm_ptr;
+        return *mission_vm;
     }
 
     return nullptr;
-}
\ No newline at end of file
+}
+
+UMSMissionViewModel * UMSViewModel::AddMissionViewModel( UMSMission * mission )
+{
+    UMSMissionViewModel * mission_vm = nullptr;
+
+    if ( MissionViewModelPool.Num() > 0 )
+    {
+        mission_vm = MissionViewModelPool.Pop();
+    }
+    else
+    {
+        mission_vm = NewObject< UMSMissionViewModel >( this );
+        ++MissionViewModelCount;
+    }
+
+    mission_vm->Initialize( mission );
+
+    MissionViewModels.Add( mission, mission_vm );
+    ActiveMissions.Add( mission_vm );
+
+    return mission_vm;
+}
+
+void UMSViewModel::CreateViewModels()
+{
+    bAreViewModelsCreated = true;
+
+    for ( const auto & mission : Missions )
+    {
+        auto * mission_vm = AddMissionViewModel( mission );
+
+        // The objectives which started before the view models were created are read from the mission
+        for ( const auto * objective : mission->GetObjectives() )
+        {
+            if ( !objective->HasEnded() )
+            {
+                mission_vm->SetObjectiveStarted( objective->GetClass() );
+            }
+        }
+    }
+}
+
+void UMSViewModel::MarkDirty( UMSMissionViewModel * mission_vm )
+{
+    if ( mission_vm != nullptr )
+    {
+        DirtyMissionViewModels.AddUnique( mission_vm );
+    }
+
+    if ( !EndFrameDelegateHandle.IsValid() )
+    {
+        EndFrameDelegateHandle = FCoreDelegates::OnEndFrame.AddUObject( this, &UMSViewModel::FlushChanges );
+    }
+}
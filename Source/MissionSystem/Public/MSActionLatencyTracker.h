@@ -0,0 +1,84 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/ObjectKey.h>
+#include <UObject/WeakObjectPtr.h>
+
+class UMSMissionAction;
+
+/* Histogram of the time the actions of a class took between their Execute and their FinishExecute */
+struct MISSIONSYSTEM_API FMSActionLatencyHistogram
+{
+    static constexpr int32 BucketCount = 12;
+
+    // Upper bound, in seconds, of each bucket. The last bucket holds all the longer latencies
+    static const double BucketUpperBounds[ BucketCount - 1 ];
+
+    void Add( double seconds );
+    void Append( const FMSActionLatencyHistogram & other );
+    double GetAverage() const;
+
+    // Approximated by the upper bound of the bucket which holds the percentile, clamped to the longest latency
+    double GetPercentile( double percentile ) const;
+
+    uint32 Count = 0;
+    double TotalSeconds = 0.0;
+    double MaxSeconds = 0.0;
+    uint32 Buckets[ BucketCount ] = {};
+};
+
+/* Measures the latency of the actions executed by a mission system component, in a histogram per action class,
+ and keeps the start time of the actions which did not call FinishExecute yet, to find the actions which stall their mission.
+ */
+class MISSIONSYSTEM_API FMSActionLatencyTracker
+{
+public:
+    struct FOutstandingAction
+    {
+        // False once the action was destroyed or reset, as it will not call FinishExecute for the execution which started the entry
+        bool IsCurrent() const;
+
+        TWeakObjectPtr< const UMSMissionAction > Action;
+
+        // Generation of the action when it started. A pooled action is reset before being reused, which gives it a new generation
+        uint32 Generation = 0;
+        double StartTime = 0.0;
+        bool bPassedDeadline = false;
+    };
+
+    const TMap< FName, FMSActionLatencyHistogram > & GetHistograms() const;
+    const TMap< TObjectKey< UMSMissionAction >, FOutstandingAction > & GetOutstandingActions() const;
+
+    void OnActionStarted( const UMSMissionAction & action, double time );
+
+    // Adds the latency of the action to the histogram of its class, and returns the action as it was outstanding. Returns an unset value if the action was not started, or was reset since
+    TOptional< FOutstandingAction > OnActionFinished( const UMSMissionAction & action, double time );
+
+    // Forgets an action released before it finished, without adding it to the histograms
+    void OnActionCancelled( const UMSMissionAction & action );
+
+    // Returns the outstanding actions which passed the deadline since the previous call, and forgets the actions which are no longer current
+    TArray< FOutstandingAction > GetActionsPastDeadline( double time, double deadline );
+
+    void Reset();
+
+    // Prints the action classes with the longest latencies, merged over all the trackers, then the outstanding actions from the oldest
+    static void Dump( TConstArrayView< const FMSActionLatencyTracker * > trackers, double time, int32 max_count, FOutputDevice & output_device );
+
+private:
+    TMap< FName, FMSActionLatencyHistogram > Histograms;
+
+    // The actions are removed when their executor releases them. The entries of the actions which were destroyed or reused without being
+    // released are told apart by the serial number of the object key and by the generation of the action
+    TMap< TObjectKey< UMSMissionAction >, FOutstandingAction > OutstandingActions;
+};
+
+FORCEINLINE const TMap< FName, FMSActionLatencyHistogram > & FMSActionLatencyTracker::GetHistograms() const
+{
+    return Histograms;
+}
+
+FORCEINLINE const TMap< TObjectKey< UMSMissionAction >, FMSActionLatencyTracker::FOutstandingAction > & FMSActionLatencyTracker::GetOutstandingActions() const
+{
+    return OutstandingActions;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "MSActionPool.generated.h"
+
+class UMSMissionAction;
+
+USTRUCT()
+struct FMSPooledActions
+{
+    GENERATED_USTRUCT_BODY()
+
+    UPROPERTY()
+    TArray< TObjectPtr< UMSMissionAction > > Actions;
+};
+
+/* Keeps the actions duplicated from the instanced actions of the mission data and the objectives, per template, to avoid duplicating them each time they are executed */
+USTRUCT()
+struct MISSIONSYSTEM_API FMSActionPool
+{
+    GENERATED_USTRUCT_BODY()
+
+public:
+    FMSActionPool();
+
+    uint32 GetHitCount() const;
+    uint32 GetMissCount() const;
+    int32 GetPooledActionCount() const;
+
+    // Returns an action previously duplicated from action_template if one is available, or duplicates the template with the given outer
+    UMSMissionAction * Acquire( UObject * outer, const UMSMissionAction * action_template, bool use_pool );
+
+    // Resets the action and makes it available for Acquire. The action is left to the garbage collector if the pool of its template is full
+    void Release( UMSMissionAction * action, int32 max_actions_per_template );
+    void Reset();
+
+private:
+    UPROPERTY()
+    TMap< TObjectPtr< const UMSMissionAction >, FMSPooledActions > PooledActions;
+
+    uint32 HitCount;
+    uint32 MissCount;
+    int32 PooledActionCount;
+};
+
+FORCEINLINE uint32 FMSActionPool::GetHitCount() const
+{
+    return HitCount;
+}
+
+FORCEINLINE uint32 FMSActionPool::GetMissCount() const
+{
+    return MissCount;
+}
+
+FORCEINLINE int32 FMSActionPool::GetPooledActionCount() const
+{
+    return PooledActionCount;
+}
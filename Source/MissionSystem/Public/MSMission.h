@@ -8,6 +8,8 @@
 
 class UMSMissionAction;
 class UMSMissionData;
+class UMSMissionGraph;
+struct FMSMissionHistory;
 class UMSMissionObjective;
 class UMSMission;
 
@@ -50,14 +52,29 @@ public:
     UMSMissionData * GetMissionData() const;
 
 private:
+    // Without a graph, mission_graph is null and the finished objectives are found in the history by class
+    void InitializeObjectives( const FMSMissionHistory & mission_history, const UMSMissionGraph * mission_graph, int32 mission_index );
+
+    // Decrements the dependency counters of the objectives which depend on objective_index, and adds the ones which can start to ReadyObjectives
+    void ReleaseDependents( int32 objective_index );
+
+    // Decrements the counters of running prerequisites of the objectives which depend on objective_index, and executes the barrier actions of the ones left without any
+    void ReleaseBarriers( int32 objective_index );
+
+    // Completes an objective ignored by the tags of the component without executing it, and releases its dependents
+    void IgnoreObjective( int32 objective_index );
+    void OnObjectiveEndActionsStarted( UMSMissionObjective * mission_objective );
     void OnObjectiveCompleted( UMSMissionObjective * mission_objective, bool was_cancelled );
+    void ScheduleNextObjective();
     void TryStart();
     void TryEnd();
+    void ReleaseObjectives();
 
     UFUNCTION()
     void ExecuteNextObjective();
 
-    bool CanExecuteObjective( const TSubclassOf< UMSMissionObjective > & objective_class ) const;
+    // Whether all the prerequisites of the objective have ended. Objective indices are the indices in the Objectives of the mission data
+    bool CanExecuteObjective( int32 objective_index ) const;
 
     UPROPERTY( BlueprintReadOnly, meta = ( AllowPrivateAccess = true ) )
     UMSMissionData * Data;
@@ -69,8 +86,27 @@ private:
     UPROPERTY( BlueprintReadOnly, meta = ( AllowPrivateAccess = true ) )
     TArray< TObjectPtr< UMSMissionObjective > > ActiveObjectives;
 
+    // Classes of the objectives to execute, by objective index. Null for the objectives which are disabled or already finished
     UPROPERTY()
-    TArray< TSubclassOf< UMSMissionObjective > > PendingObjectives;
+    TArray< TSubclassOf< UMSMissionObjective > > ObjectiveClasses;
+
+    // Number of prerequisites of each objective which have not ended yet, initialized from the dependencies compiled in the mission data.
+    // When the mission pipelines its objectives, the prerequisites are counted until they are completed instead
+    TArray< int32 > RemainingDependencyCounts;
+
+    // Number of prerequisites of each objective whose end actions have not finished yet. The barrier actions of the objective wait until it drops to zero
+    TArray< int32 > RunningPrerequisiteCounts;
+
+    // Objectives whose prerequisites have all ended, started by the next ExecuteNextObjective
+    TArray< int32 > ReadyObjectives;
+
+    TMap< const UMSMissionObjective *, int32 > ActiveObjectiveIndices;
+
+    // The started objectives by objective index, to find the dependents which hold barrier actions without scanning ActiveObjectives
+    TMap< int32, UMSMissionObjective * > ActiveObjectivesByIndex;
+
+    // Number of objectives to execute which have not ended yet
+    int32 RemainingObjectiveCount;
 
     UPROPERTY()
     FMSActionExecutor StartActionsExecutor;
@@ -15,10 +15,26 @@ class MISSIONSYSTEM_API UMSMissionAction : public UObject
     GENERATED_BODY()
 
 public:
+    UMSMissionAction();
+
     FMSOnMissionActionCompleteDelegate & OnMissionActionComplete();
+    bool IsPipelineBarrier() const;
+
+    // Returns the instanced action this action was duplicated from, if it was acquired from the action pool
+    const UMSMissionAction * GetTemplate() const;
+
+    // Incremented each time the action is reset, so what was scheduled for a previous execution of the action can be told apart
+    uint32 GetGeneration() const;
+
+    // Name of the action class, followed by the name of the mission data or of the objective which holds the action template
+    FString GetDescription() const;
 
     void Initialize( UObject * world_context );
 
+    // Puts the action back in its initial state so it can be executed again. Called when the action is returned to the pool.
+    // The properties are restored from the template of the action, or from its archetype for the actions instanced in an objective
+    void ResetAction();
+
     /* Executes the actions. You must call FinishExecute to notify the parent objective / mission it can continue execution  */
     UFUNCTION( BlueprintNativeEvent )
     void Execute();
@@ -29,11 +45,47 @@ public:
     UWorld * GetWorld() const override;
 
 protected:
+    friend struct FMSActionPool;
+
+    // Called when a pooled action is reset before being reused, before its properties are restored.
+    // Clean up here what the execution created outside of the action, like spawned actors
+    UFUNCTION( BlueprintNativeEvent, DisplayName = "OnReset" )
+    void K2_OnReset();
+
+    // :NOTE: The instanced objects are not copied, as they would be shared with the template. Reset them in OnReset
+    void RestoreTemplateProperties();
+
+    // When the mission pipelines its objectives, a start action of an objective which is a barrier waits for the end actions of the prerequisites of the objective to finish.
+    // Use it for the actions which must not overlap with them, like a fade in which must follow a fade out
+    UPROPERTY( EditDefaultsOnly, Category = "Pipelining" )
+    uint8 bIsPipelineBarrier : 1;
+
     FMSOnMissionActionCompleteDelegate OnMissionActionCompleteEvent;
     TWeakObjectPtr< UObject > Outer;
+
+    // The instanced action of the mission data or of the objective this action was duplicated from
+    UPROPERTY( Transient )
+    TObjectPtr< const UMSMissionAction > Template;
+
+    uint32 Generation;
 };
 
 FORCEINLINE FMSOnMissionActionCompleteDelegate & UMSMissionAction::OnMissionActionComplete()
 {
     return OnMissionActionCompleteEvent;
+}
+
+FORCEINLINE bool UMSMissionAction::IsPipelineBarrier() const
+{
+    return bIsPipelineBarrier;
+}
+
+FORCEINLINE const UMSMissionAction * UMSMissionAction::GetTemplate() const
+{
+    return Template;
+}
+
+FORCEINLINE uint32 UMSMissionAction::GetGeneration() const
+{
+    return Generation;
 }
\ No newline at end of file
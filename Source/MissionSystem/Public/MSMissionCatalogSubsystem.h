@@ -0,0 +1,51 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Subsystems/EngineSubsystem.h>
+#include <UObject/SoftObjectPath.h>
+
+#include "MSMissionCatalogSubsystem.generated.h"
+
+class UMSMissionData;
+class UMSMissionObjective;
+struct FAssetData;
+
+/* Maps the GUIDs of the missions and of the objectives to the paths of their assets, using the tags exported to the asset registry.
+ No mission asset is loaded to build the catalog, so the mission history can be queried and loaded with GUIDs only,
+ and the mission data are only loaded when a mission actually runs.
+ In cooked builds, the MissionId and ObjectiveId tags must be allowed in the CookedTagsAllowList of the asset registry settings.
+ */
+UCLASS()
+class MISSIONSYSTEM_API UMSMissionCatalogSubsystem final : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UMSMissionCatalogSubsystem * Get();
+
+    void Initialize( FSubsystemCollectionBase & collection ) override;
+    void Deinitialize() override;
+
+    FSoftObjectPath GetMissionPath( const FGuid & mission_id ) const;
+    FSoftClassPath GetObjectivePath( const FGuid & objective_id ) const;
+
+    // Returns the ID of the objective without creating the CDO of the class, if the class is known by the catalog
+    FGuid GetObjectiveId( const UClass * objective_class ) const;
+
+    // Synchronously loads the mission data if needed
+    UMSMissionData * LoadMissionData( const FGuid & mission_id ) const;
+
+    // Registers mission data which are not known by the asset registry, like transient missions
+    void AddMissionData( const UMSMissionData * mission_data );
+
+private:
+    void Rebuild();
+    void OnAssetAdded( const FAssetData & asset_data );
+    void OnAssetRemoved( const FAssetData & asset_data );
+    void AddMissionAsset( const FAssetData & asset_data );
+    void AddObjectiveAsset( const FAssetData & asset_data );
+
+    TMap< FGuid, FSoftObjectPath > MissionPaths;
+    TMap< FGuid, FSoftClassPath > ObjectivePaths;
+    TMap< FSoftClassPath, FGuid > ObjectiveIds;
+};
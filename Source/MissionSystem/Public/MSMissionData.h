@@ -2,6 +2,8 @@
 
 #include "MSMissionAction.h"
 #include "MSMissionObjective.h"
+#include "MSMissionScheduler.h"
+#include "MSObjectiveDependencies.h"
 
 #include <CoreMinimal.h>
 #include <Engine/DataAsset.h>
@@ -16,11 +18,22 @@ struct MISSIONSYSTEM_API FMSMissionObjectiveData
     FMSMissionObjectiveData();
     FMSMissionObjectiveData( const TSubclassOf< UMSMissionObjective > & objective, bool enabled = true );
 
+    // Soft, so the objective blueprint is only loaded when the mission is about to start
     UPROPERTY( EditDefaultsOnly )
-    TSubclassOf< UMSMissionObjective > Objective;
+    TSoftClassPtr< UMSMissionObjective > Objective;
 
     UPROPERTY( EditDefaultsOnly )
     uint8 bEnabled : 1;
+
+    // When set, the objective starts at the same time as the previous enabled objective, in the same parallel group.
+    // The mission moves on to the next group once all the objectives of the group have ended
+    UPROPERTY( EditDefaultsOnly )
+    uint8 bStartWithPreviousObjective : 1;
+
+    // Objectives of the same mission which must end before this one starts. When set, the objective ignores its position in the list,
+    // and starts as soon as all its prerequisites have ended. A prerequisite placed after this objective in the list, without prerequisites of its own, starts with the mission
+    UPROPERTY( EditDefaultsOnly )
+    TArray< TSoftClassPtr< UMSMissionObjective > > Prerequisites;
 };
 
 UCLASS( BlueprintType )
@@ -32,6 +45,11 @@ public:
     UMSMissionData();
 
     const FGuid & GetGuid() const;
+    const FMSObjectiveDependencies & GetObjectiveDependencies() const;
+
+    // Must be called after the objectives are modified at runtime. Done automatically when the mission data is loaded, edited or saved
+    void CompileObjectiveDependencies();
+
     void PostLoad() override;
     void PostDuplicate( bool duplicate_for_pie ) override;
     void PostEditImport() override;
@@ -51,11 +69,12 @@ public:
     UPROPERTY( EditDefaultsOnly, Category = "ActiveObjectives" )
     TArray< FMSMissionObjectiveData > Objectives;
 
+    // Soft, so loading a mission does not load the rest of the campaign. The mission system component prefetches them while the mission runs
     UPROPERTY( EditDefaultsOnly, Category = "Other missions" )
-    TArray< UMSMissionData * > NextMissions;
+    TArray< TSoftObjectPtr< UMSMissionData > > NextMissions;
 
     UPROPERTY( EditDefaultsOnly, Category = "Other missions" )
-    TArray< UMSMissionData * > MissionsToCancel;
+    TArray< TSoftObjectPtr< UMSMissionData > > MissionsToCancel;
 
     UPROPERTY( EditDefaultsOnly, Category = "Options" )
     uint8 bEnabled : 1;
@@ -66,18 +85,36 @@ public:
     UPROPERTY( EditDefaultsOnly, Category = "Options" )
     uint8 bStartNextMissionsWhenCancelled : 1;
 
-    UPROPERTY( VisibleAnywhere, AdvancedDisplay )
+    // When set, the objectives which depend on an objective start as soon as it is completed, while its end actions are still running.
+    // The start actions flagged as pipeline barriers still wait for the end actions of the prerequisites of their objective to finish
+    UPROPERTY( EditDefaultsOnly, Category = "Options" )
+    uint8 bPipelineObjectiveActions : 1;
+
+    // Order in which the mission is started, relative to the other pending transitions, when the mission system component time slices its transitions
+    UPROPERTY( EditDefaultsOnly, Category = "Options" )
+    EMSMissionTransitionPriority Priority;
+
+    UPROPERTY( VisibleAnywhere, AdvancedDisplay, AssetRegistrySearchable )
     FGuid MissionId;
 
 #if WITH_EDITOR
+    void PreSave( FObjectPreSaveContext object_save_context ) override;
+    void PostEditChangeProperty( FPropertyChangedEvent & property_changed_event ) override;
     EDataValidationResult IsDataValid( FDataValidationContext & context ) const override;
 #endif
 
 private:
     void GenerateGuidIfNeeded( bool force_generation = false );
+
+    FMSObjectiveDependencies ObjectiveDependencies;
 };
 
 FORCEINLINE const FGuid & UMSMissionData::GetGuid() const
 {
     return MissionId;
+}
+
+FORCEINLINE const FMSObjectiveDependencies & UMSMissionData::GetObjectiveDependencies() const
+{
+    return ObjectiveDependencies;
 }
\ No newline at end of file
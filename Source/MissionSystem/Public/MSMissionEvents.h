@@ -0,0 +1,46 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Templates/SubclassOf.h>
+
+#include "MSMissionEvents.generated.h"
+
+class UMSMission;
+class UMSMissionData;
+class UMSMissionObjective;
+
+UENUM( BlueprintType )
+enum class EMSMissionEventType : uint8
+{
+    MissionStarted,
+    MissionEnded,
+    ObjectiveStarted,
+    ObjectiveEnded
+};
+
+/* A mission or objective event, as dispatched by the mission system component to the listeners of the batched events */
+USTRUCT( BlueprintType )
+struct MISSIONSYSTEM_API FMSMissionEvent
+{
+    GENERATED_USTRUCT_BODY()
+
+    FMSMissionEvent();
+    FMSMissionEvent( EMSMissionEventType type, UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective = nullptr, bool was_cancelled = false );
+
+    UPROPERTY( BlueprintReadOnly )
+    EMSMissionEventType Type;
+
+    UPROPERTY( BlueprintReadOnly )
+    TObjectPtr< UMSMission > Mission;
+
+    UPROPERTY( BlueprintReadOnly )
+    TObjectPtr< UMSMissionData > MissionData;
+
+    // Only set for the objective events
+    UPROPERTY( BlueprintReadOnly )
+    TSubclassOf< UMSMissionObjective > Objective;
+
+    // Only set for the end events
+    UPROPERTY( BlueprintReadOnly )
+    bool bWasCancelled;
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Engine/DataAsset.h>
+
+#include "MSMissionGraph.generated.h"
+
+class UMSMissionData;
+class UMSMissionObjective;
+
+USTRUCT()
+struct MISSIONSYSTEM_API FMSCompiledMission
+{
+    GENERATED_USTRUCT_BODY()
+
+    FMSCompiledMission();
+
+    UPROPERTY( VisibleAnywhere )
+    TSoftObjectPtr< UMSMissionData > MissionData;
+
+    // Range in UMSMissionGraph::MissionObjectives of the enabled objectives of the mission, in execution order
+    UPROPERTY( VisibleAnywhere )
+    int32 FirstObjective;
+
+    UPROPERTY( VisibleAnywhere )
+    int32 ObjectiveCount;
+
+    // Range in UMSMissionGraph::NextMissionEdges
+    UPROPERTY( VisibleAnywhere )
+    int32 FirstNextMission;
+
+    UPROPERTY( VisibleAnywhere )
+    int32 NextMissionCount;
+
+    // Range in UMSMissionGraph::MissionToCancelEdges
+    UPROPERTY( VisibleAnywhere )
+    int32 FirstMissionToCancel;
+
+    UPROPERTY( VisibleAnywhere )
+    int32 MissionToCancelCount;
+
+    UPROPERTY( VisibleAnywhere )
+    uint8 bEnabled : 1;
+};
+
+/* Immutable, flattened version of all the mission data of the project.
+ Missions and objectives are given dense indices, and the links between them are stored as ranges of indices in flat arrays.
+ The graph is compiled when it is saved in the editor, and when it is cooked, so it always reflects the mission data.
+ When the mission system component references a graph, missions start and chain using the graph instead of the mission data,
+ and the mission history uses the indices of the graph.
+ Compiling the graph again keeps the index of the missions and objectives it already contains, and appends the new ones, so the histories
+ saved with the indices of a previous compilation can still be loaded. The missions and objectives which were removed keep their index, without data.
+ */
+UCLASS( BlueprintType )
+class MISSIONSYSTEM_API UMSMissionGraph final : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // Identifies the graph across its compilations, so the histories saved with the indices of another graph are not loaded with this one
+    const FGuid & GetGraphId() const;
+    TConstArrayView< FGuid > GetMissionIds() const;
+    TConstArrayView< FGuid > GetObjectiveIds() const;
+    const FMSCompiledMission & GetMission( int32 mission_index ) const;
+    const TSoftClassPtr< UMSMissionObjective > & GetObjective( int32 objective_index ) const;
+    TConstArrayView< int32 > GetMissionObjectives( int32 mission_index ) const;
+
+    // Index in the Objectives of the mission data of each objective of GetMissionObjectives. Empty for the graphs compiled before it was stored
+    TConstArrayView< int32 > GetMissionObjectiveSlots( int32 mission_index ) const;
+    TConstArrayView< int32 > GetNextMissions( int32 mission_index ) const;
+    TConstArrayView< int32 > GetMissionsToCancel( int32 mission_index ) const;
+
+    int32 FindMissionIndex( const FGuid & mission_id ) const;
+    int32 FindObjectiveIndex( const FGuid & objective_id ) const;
+
+    // Synchronously loads the mission data if needed
+    UMSMissionData * LoadMissionData( int32 mission_index ) const;
+
+    void PostLoad() override;
+
+#if WITH_EDITOR
+    void PreSave( FObjectPreSaveContext object_save_context ) override;
+
+    // Compiles all the mission data found in the asset registry, and the missions they reference
+    void Compile();
+    void Compile( const TArray< UMSMissionData * > & missions );
+#endif
+
+private:
+    void BuildIndices();
+
+    UPROPERTY( VisibleAnywhere, Category = "Graph" )
+    FGuid GraphId;
+
+    UPROPERTY( VisibleAnywhere, Category = "Missions" )
+    TArray< FGuid > MissionIds;
+
+    UPROPERTY( VisibleAnywhere, Category = "Missions" )
+    TArray< FMSCompiledMission > Missions;
+
+    UPROPERTY( VisibleAnywhere, Category = "Objectives" )
+    TArray< FGuid > ObjectiveIds;
+
+    UPROPERTY( VisibleAnywhere, Category = "Objectives" )
+    TArray< TSoftClassPtr< UMSMissionObjective > > Objectives;
+
+    // Indices in Objectives
+    UPROPERTY( VisibleAnywhere, Category = "Edges" )
+    TArray< int32 > MissionObjectives;
+
+    // Parallel to MissionObjectives. Index of each objective in the Objectives array of its mission data,
+    // so the missions find the dependencies of their objectives compiled in the mission data
+    UPROPERTY( VisibleAnywhere, Category = "Edges" )
+    TArray< int32 > MissionObjectiveSlots;
+
+    // Indices in Missions
+    UPROPERTY( VisibleAnywhere, Category = "Edges" )
+    TArray< int32 > NextMissionEdges;
+
+    // Indices in Missions
+    UPROPERTY( VisibleAnywhere, Category = "Edges" )
+    TArray< int32 > MissionToCancelEdges;
+
+    TMap< FGuid, int32 > MissionIndices;
+    TMap< FGuid, int32 > ObjectiveIndices;
+};
+
+FORCEINLINE const FGuid & UMSMissionGraph::GetGraphId() const
+{
+    return GraphId;
+}
+
+FORCEINLINE TConstArrayView< FGuid > UMSMissionGraph::GetMissionIds() const
+{
+    return MissionIds;
+}
+
+FORCEINLINE TConstArrayView< FGuid > UMSMissionGraph::GetObjectiveIds() const
+{
+    return ObjectiveIds;
+}
+
+FORCEINLINE const FMSCompiledMission & UMSMissionGraph::GetMission( const int32 mission_index ) const
+{
+    return Missions[ mission_index ];
+}
+
+FORCEINLINE const TSoftClassPtr< UMSMissionObjective > & UMSMissionGraph::GetObjective( const int32 objective_index ) const
+{
+    return Objectives[ objective_index ];
+}
+
+FORCEINLINE TConstArrayView< int32 > UMSMissionGraph::GetMissionObjectives( const int32 mission_index ) const
+{
+    const auto & mission = Missions[ mission_index ];
+    return MakeArrayView( MissionObjectives ).Slice( mission.FirstObjective, mission.ObjectiveCount );
+}
+
+FORCEINLINE TConstArrayView< int32 > UMSMissionGraph::GetMissionObjectiveSlots( const int32 mission_index ) const
+{
+    const auto & mission = Missions[ mission_index ];
+
+    if ( MissionObjectiveSlots.Num() != MissionObjectives.Num() )
+    {
+        return {};
+    }
+
+    return MakeArrayView( MissionObjectiveSlots ).Slice( mission.FirstObjective, mission.ObjectiveCount );
+}
+
+FORCEINLINE TConstArrayView< int32 > UMSMissionGraph::GetNextMissions( const int32 mission_index ) const
+{
+    const auto & mission = Missions[ mission_index ];
+    return MakeArrayView( NextMissionEdges ).Slice( mission.FirstNextMission, mission.NextMissionCount );
+}
+
+FORCEINLINE TConstArrayView< int32 > UMSMissionGraph::GetMissionsToCancel( const int32 mission_index ) const
+{
+    const auto & mission = Missions[ mission_index ];
+    return MakeArrayView( MissionToCancelEdges ).Slice( mission.FirstMissionToCancel, mission.MissionToCancelCount );
+}
+
+FORCEINLINE int32 UMSMissionGraph::FindMissionIndex( const FGuid & mission_id ) const
+{
+    const auto * index = MissionIndices.Find( mission_id );
+    return index != nullptr ? *index : INDEX_NONE;
+}
+
+FORCEINLINE int32 UMSMissionGraph::FindObjectiveIndex( const FGuid & objective_id ) const
+{
+    const auto * index = ObjectiveIndices.Find( objective_id );
+    return index != nullptr ? *index : INDEX_NONE;
+}
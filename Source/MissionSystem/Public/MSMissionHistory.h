@@ -1,18 +1,14 @@
 #pragma once
 
+#include "MSMissionStateTable.h"
+
 #include <CoreMinimal.h>
 
 #include "MSMissionHistory.generated.h"
 
 class UMSMissionObjective;
 class UMSMissionData;
-
-enum class EMSState : uint8
-{
-    Active,
-    Cancelled,
-    Complete
-};
+class UMSMissionGraph;
 
 USTRUCT()
 struct MISSIONSYSTEM_API FMSMissionHistory
@@ -20,39 +16,124 @@ struct MISSIONSYSTEM_API FMSMissionHistory
     GENERATED_USTRUCT_BODY()
 
 public:
-    const TArray< UMSMissionData * > & GetActiveMissionData() const;
+    const TArray< FGuid > & GetActiveMissionIds() const;
+    const FMSMissionStateTable & GetMissionStates() const;
+    const FMSMissionStateTable & GetObjectiveStates() const;
+
+    // Number of missions and objectives indexed by the mission graph the history is bound to
+    int32 GetGraphMissionCount() const;
+    int32 GetGraphObjectiveCount() const;
 
     bool HasData() const;
 
+    bool IsMissionActive( const FGuid & mission_id ) const;
+    bool IsMissionCancelled( const FGuid & mission_id ) const;
+    bool IsMissionComplete( const FGuid & mission_id ) const;
+    bool IsMissionFinished( const FGuid & mission_id ) const;
     bool IsMissionActive( UMSMissionData * mission_data ) const;
     bool IsMissionCancelled( UMSMissionData * mission_data ) const;
     bool IsMissionComplete( UMSMissionData * mission_data ) const;
     bool IsMissionFinished( UMSMissionData * mission_data ) const;
     bool AddActiveMission(UMSMissionData* mission_data);
     bool SetMissionComplete( UMSMissionData * mission_data, bool was_cancelled );
+    int32 FindMissionIndex( UMSMissionData * mission_data ) const;
 
+    // objective_index is the index of the objective in the mission graph the history is bound to
+    bool IsObjectiveFinished( int32 objective_index ) const;
+    bool IsObjectiveActive( const FGuid & objective_id ) const;
+    bool IsObjectiveCancelled( const FGuid & objective_id ) const;
+    bool IsObjectiveComplete( const FGuid & objective_id ) const;
+    bool IsObjectiveFinished( const FGuid & objective_id ) const;
     bool IsObjectiveActive( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const;
     bool IsObjectiveCancelled( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const;
     bool IsObjectiveComplete( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const;
     bool IsObjectiveFinished( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const;
     bool AddActiveObjective( const TSubclassOf< UMSMissionObjective > & mission_objective_class );
     bool SetObjectiveComplete( const TSubclassOf< UMSMissionObjective > & mission_objective_class, bool was_cancelled );
+    int32 FindObjectiveIndex( const TSubclassOf< UMSMissionObjective > & mission_objective_class ) const;
+
+    // Used by the clients to mirror the states replicated by the server. An unset state removes the mission or objective from the history
+    void SetMissionState( const FGuid & mission_id, TOptional< EMSState > state );
+    void SetObjectiveState( const FGuid & objective_id, TOptional< EMSState > state );
+
+    // Gives the missions and objectives the same indices as in the mission graph. The history stays bound when it is loaded or cleared.
+    // A history saved with the indices of a graph can be loaded before it is bound, and its states get their ID once it is bound to the same graph
+    void BindToGraph( const UMSMissionGraph & mission_graph );
 
-    friend FArchive & operator<<( FArchive & archive, FMSMissionHistory & mission_history );
+    friend MISSIONSYSTEM_API FArchive & operator<<( FArchive & archive, FMSMissionHistory & mission_history );
     void Clear();
 
+    // Number of missions and objectives whose state changed since the last checkpoint
+    int32 GetChangeCount() const;
+
+    // Set after Clear, when the changes since the last checkpoint can not be saved as a journal entry and the whole history must be saved
+    bool NeedsSnapshot() const;
+
+    // Forgets the changes. Called once the history or its changes have been saved. Loading the history also starts a new checkpoint
+    void Checkpoint();
+
+    // Saving writes the states which changed since the last checkpoint, without starting a new checkpoint.
+    // Loading applies the saved states on top of the current ones, only if they could all be read. Returns the number of saved states
+    int32 SerializeChanges( FArchive & archive );
+
 private:
     bool DoesMissionHasState( UMSMissionData * mission_data, EMSState state ) const;
     bool DoesObjectiveHasState( const TSubclassOf< UMSMissionObjective > & mission_objective_class, EMSState state ) const;
+    void SerializeInitialVersion( FArchive & archive, int32 active_missions_count );
+    void SerializeActiveMissionsData( FArchive & archive, int32 active_missions_count );
+    void SerializeCompact( FArchive & archive, int32 version );
+    void SerializeCompactBody( FArchive & archive, int32 version );
 
     UPROPERTY()
-    TArray< UMSMissionData * > ActiveMissionsData;
+    TArray< FGuid > ActiveMissionIds;
+
+    FMSMissionStateTable MissionStates;
+    FMSMissionStateTable ObjectiveStates;
+
+    // The graph the history is bound to, or the graph of the loaded history until it is bound
+    FGuid GraphId;
+    bool bIsBoundToGraph = false;
 
-    TMap< FGuid, EMSState > MissionStates;
-    TMap< FGuid, EMSState > ObjectiveStates;
+    // Active missions of a loaded history, indexed by a graph the history is not bound to yet
+    TArray< int32 > UnboundActiveMissionIndices;
+
+    // Not serialized. Missions and objectives whose state changed since the last checkpoint
+    TSet< FGuid > ChangedMissionIds;
+    TSet< FGuid > ChangedObjectiveIds;
+    bool bNeedsSnapshot = false;
 };
 
-FORCEINLINE const TArray< UMSMissionData * > & FMSMissionHistory::GetActiveMissionData() const
+FORCEINLINE const TArray< FGuid > & FMSMissionHistory::GetActiveMissionIds() const
+{
+    return ActiveMissionIds;
+}
+
+FORCEINLINE const FMSMissionStateTable & FMSMissionHistory::GetMissionStates() const
+{
+    return MissionStates;
+}
+
+FORCEINLINE const FMSMissionStateTable & FMSMissionHistory::GetObjectiveStates() const
+{
+    return ObjectiveStates;
+}
+
+FORCEINLINE int32 FMSMissionHistory::GetGraphMissionCount() const
+{
+    return MissionStates.GetBoundCount();
+}
+
+FORCEINLINE int32 FMSMissionHistory::GetGraphObjectiveCount() const
+{
+    return ObjectiveStates.GetBoundCount();
+}
+
+FORCEINLINE int32 FMSMissionHistory::GetChangeCount() const
+{
+    return ChangedMissionIds.Num() + ChangedObjectiveIds.Num();
+}
+
+FORCEINLINE bool FMSMissionHistory::NeedsSnapshot() const
 {
-    return ActiveMissionsData;
+    return bNeedsSnapshot;
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/* Versions of the serialized mission history
+ Histories saved before versioning start with the number of active missions. Versioned histories start with HeaderTag instead, followed by the version.
+ The version is also registered as a custom version, so the packages which contain a history record it
+ */
+struct MISSIONSYSTEM_API FMSMissionHistoryVersion
+{
+    enum Type : int32
+    {
+        // Active missions, and maps from GUID to state for missions and objectives
+        Initial = 0,
+
+        // States stored in dense tables, 2 bits per mission or objective
+        DenseStateTables,
+
+        // Active missions stored as GUIDs instead of references to the mission data
+        ActiveMissionIds,
+
+        // Only the entries which have a state are saved, with varint counts, active missions as varint indices in the mission table, and optional compression
+        CompactEncoding,
+
+        // The missions and objectives of the mission graph are saved as 2 bits states at their index in the graph, without their GUID
+        GraphIndices,
+
+        // -----<new versions can be added above this line>-------------------------------------------------
+        VersionPlusOne,
+        LatestVersion = VersionPlusOne - 1
+    };
+
+    static constexpr int32 HeaderTag = -1;
+
+    static const FGuid GUID;
+
+private:
+    FMSMissionHistoryVersion() = delete;
+};
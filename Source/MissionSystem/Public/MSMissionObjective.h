@@ -12,6 +12,7 @@ class UMSMissionAction;
 class UMSMissionObjective;
 
 DECLARE_EVENT_TwoParams( UMSMissionObjective, FMSOnObjectiveEndedEvent, UMSMissionObjective * MissionObjective, bool WasCancelled );
+DECLARE_EVENT_OneParam( UMSMissionObjective, FMSOnObjectiveEndActionsStartedEvent, UMSMissionObjective * MissionObjective );
 
 UCLASS( Abstract, BlueprintType, Blueprintable )
 class MISSIONSYSTEM_API UMSMissionObjective : public UObject, public IGameplayTagAssetInterface
@@ -22,12 +23,29 @@ public:
     UMSMissionObjective();
 
     FMSOnObjectiveEndedEvent & OnObjectiveEnded();
+
+    // Broadcast when the objective is completed, right before its end actions are executed
+    FMSOnObjectiveEndActionsStartedEvent & OnObjectiveEndActionsStarted();
     const FText & GetDescription() const;
+    const FGameplayTagContainer & GetTags() const;
 
     const FGuid & GetGuid() const;
     bool IsComplete() const;
     bool IsCancelled() const;
-    void Execute();
+    bool HasEnded() const;
+
+    // The objective can not be reused while its actions can still call FinishExecute
+    bool HasExecutingActions() const;
+
+    // With hold_barrier_actions, the start actions which are pipeline barriers wait for ExecuteBarrierActions
+    void Execute( bool hold_barrier_actions = false );
+    void ExecuteBarrierActions();
+
+    // Stops waiting for the actions of the objective, once the objective has ended
+    void ReleaseActions();
+
+    // Puts the objective back in its initial state so it can be executed again. Called when the objective is returned to the pool
+    void ResetObjective();
     void PostLoad() override;
     void PostDuplicate( bool duplicate_for_pie ) override;
     void PostEditImport() override;
@@ -52,6 +70,10 @@ protected:
     UFUNCTION( BlueprintNativeEvent, DisplayName = "OnObjectiveEnded" )
     void K2_OnObjectiveEnded( bool was_cancelled );
 
+    // Called when a pooled objective is reset before being reused. Clear here any state set during the execution
+    UFUNCTION( BlueprintNativeEvent, DisplayName = "OnReset" )
+    void K2_OnReset();
+
     void GenerateGuidIfNeeded( bool force_generation = false );
 
     UPROPERTY( EditDefaultsOnly, Instanced, Category = "Actions" )
@@ -81,10 +103,14 @@ protected:
     UPROPERTY( BlueprintReadOnly, meta = ( AllowPrivateAccess = true ) )
     bool bIsCancelled;
 
-    UPROPERTY( VisibleAnywhere, AdvancedDisplay )
+    // Set once OnObjectiveEnded has been broadcast, which means no action of the objective is running anymore
+    bool bHasEnded;
+
+    UPROPERTY( VisibleAnywhere, AdvancedDisplay, AssetRegistrySearchable )
     FGuid ObjectiveId;
 
     FMSOnObjectiveEndedEvent OnObjectiveCompleteEvent;
+    FMSOnObjectiveEndActionsStartedEvent OnObjectiveEndActionsStartedEvent;
 };
 
 FORCEINLINE FMSOnObjectiveEndedEvent & UMSMissionObjective::OnObjectiveEnded()
@@ -92,11 +118,21 @@ FORCEINLINE FMSOnObjectiveEndedEvent & UMSMissionObjective::OnObjectiveEnded()
     return OnObjectiveCompleteEvent;
 }
 
+FORCEINLINE FMSOnObjectiveEndActionsStartedEvent & UMSMissionObjective::OnObjectiveEndActionsStarted()
+{
+    return OnObjectiveEndActionsStartedEvent;
+}
+
 FORCEINLINE const FText & UMSMissionObjective::GetDescription() const
 {
     return Description;
 }
 
+FORCEINLINE const FGameplayTagContainer & UMSMissionObjective::GetTags() const
+{
+    return Tags;
+}
+
 FORCEINLINE const FGuid & UMSMissionObjective::GetGuid() const
 {
     return ObjectiveId;
@@ -110,4 +146,14 @@ FORCEINLINE bool UMSMissionObjective::IsComplete() const
 FORCEINLINE bool UMSMissionObjective::IsCancelled() const
 {
     return bIsCancelled;
+}
+
+FORCEINLINE bool UMSMissionObjective::HasEnded() const
+{
+    return bHasEnded;
+}
+
+FORCEINLINE bool UMSMissionObjective::HasExecutingActions() const
+{
+    return StartActionsExecutor.HasExecutingActions() || EndActionsExecutor.HasExecutingActions();
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Engine/StreamableManager.h>
+
+class UMSMissionData;
+class UMSMissionGraph;
+
+/* Asynchronously loads the mission data and the objective classes of the missions which can start after the active missions,
+ following the next missions up to a lookahead depth, so the missions can start without a synchronous load.
+ The loaded assets are kept alive until the mission is created, or until the prefetcher is reset.
+ */
+class MISSIONSYSTEM_API FMSMissionPrefetcher
+{
+public:
+    using FOnMissionLoaded = TFunction< void( UMSMissionData * mission_data ) >;
+
+    FMSMissionPrefetcher() = default;
+    ~FMSMissionPrefetcher();
+
+    UE_NONCOPYABLE( FMSMissionPrefetcher );
+
+    int32 GetPrefetchedMissionCount() const;
+    int32 GetLoadingRequestCount() const;
+
+    // Prefetches the missions which are at most depth next mission edges away from mission_index
+    void PrefetchNextMissions( const UMSMissionGraph & mission_graph, int32 mission_index, int32 depth );
+
+    // Without a graph, the next missions of a mission are only known once its data is loaded, so each level of the lookahead is requested when the previous one is loaded
+    void PrefetchNextMissions( const UMSMissionData & mission_data, int32 depth );
+
+    // Calls on_loaded once the mission data and the classes of its objectives are loaded. on_loaded is called immediately when they already are
+    void LoadMission( const UMSMissionGraph & mission_graph, int32 mission_index, FOnMissionLoaded && on_loaded );
+    void LoadMission( const TSoftObjectPtr< UMSMissionData > & mission_data, FOnMissionLoaded && on_loaded );
+
+    // Stops keeping the assets of the mission alive. Called once the mission is created, as it then references them
+    void Release( const FSoftObjectPath & mission_path );
+    void Reset();
+
+private:
+    void LoadObjectives( UMSMissionData & mission_data, FOnMissionLoaded && on_loaded );
+    void Request( const FSoftObjectPath & mission_path, TArray< FSoftObjectPath > && paths, TFunction< void() > && on_complete );
+
+    FStreamableManager StreamableManager;
+
+    // Requests by mission data path. Without a graph, a mission has a request for its data, then another one for its objectives
+    TMultiMap< FSoftObjectPath, TSharedPtr< FStreamableHandle > > Handles;
+};
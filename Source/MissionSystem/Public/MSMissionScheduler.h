@@ -0,0 +1,172 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "MSMissionScheduler.generated.h"
+
+class UMSMission;
+class UMSMissionAction;
+class UMSMissionData;
+
+UENUM()
+enum class EMSMissionTransitionType : uint8
+{
+    // Checks the history and the mission data, then creates and starts the mission
+    StartMission,
+    // Creates and starts a mission which is active in the history
+    ResumeMission,
+    StartNextMissions,
+    ExecuteNextObjective,
+    // Only scheduled in time sliced mode. The action executor is already bound to the completion of the action
+    ExecuteAction
+};
+
+UENUM( BlueprintType )
+enum class EMSMissionTransitionPriority : uint8
+{
+    High,
+    Normal,
+    Low,
+    Count UMETA( Hidden )
+};
+
+USTRUCT()
+struct MISSIONSYSTEM_API FMSMissionTransition
+{
+    GENERATED_USTRUCT_BODY()
+
+    FMSMissionTransition();
+
+    static FMSMissionTransition MakeStartMission( UMSMissionData * mission_data );
+    static FMSMissionTransition MakeResumeMission( UMSMissionData * mission_data );
+    static FMSMissionTransition MakeStartNextMissions( UMSMissionData * mission_data );
+    static FMSMissionTransition MakeStartNextMissions( int32 mission_index );
+    static FMSMissionTransition MakeExecuteNextObjective( UMSMission * mission );
+    static FMSMissionTransition MakeExecuteAction( UMSMissionAction * action );
+
+    UPROPERTY()
+    EMSMissionTransitionType Type;
+
+    UPROPERTY()
+    EMSMissionTransitionPriority Priority;
+
+    UPROPERTY()
+    TObjectPtr< UMSMissionData > MissionData;
+
+    UPROPERTY()
+    TObjectPtr< UMSMission > Mission;
+
+    UPROPERTY()
+    TObjectPtr< UMSMissionAction > Action;
+
+    // Index of the mission in the mission graph, when the transition does not reference the mission data
+    UPROPERTY()
+    int32 MissionIndex;
+
+    // Generation of Action when the transition was scheduled. The transition is ignored if the action was reset since, to be reused from the pool
+    UPROPERTY()
+    uint32 ActionGeneration;
+
+    // Set by the scheduler, to measure how long the transition waited in the queue
+    double ScheduleTime;
+};
+
+USTRUCT()
+struct FMSMissionTransitionQueue
+{
+    GENERATED_USTRUCT_BODY()
+
+    FMSMissionTransitionQueue();
+
+    bool IsEmpty() const;
+    int32 Num() const;
+
+    UPROPERTY()
+    TArray< FMSMissionTransition > Transitions;
+
+    // Index of the next transition to process in Transitions
+    int32 FirstIndex;
+};
+
+/* Queues of the transitions of the missions and their objectives, one FIFO per priority.
+ Transitions scheduled while the queues are drained, by the delegates or by the actions which finish immediately, are appended to the queues instead of being processed recursively.
+ So there is at most one drain loop on the callstack, and the transitions of a given priority are always processed in the order they were scheduled.
+ */
+USTRUCT()
+struct MISSIONSYSTEM_API FMSMissionScheduler
+{
+    GENERATED_USTRUCT_BODY()
+
+public:
+    FMSMissionScheduler();
+
+    bool IsDraining() const;
+    int32 GetPendingTransitionCount() const;
+    int32 GetMaxPendingTransitionCount() const;
+    uint32 GetProcessedTransitionCount() const;
+
+    // How long the oldest pending transition has been waiting, in seconds
+    double GetQueueLag() const;
+
+    // Highest time a transition waited in the queues before being processed, during the last drain, in seconds
+    double GetLastDrainMaxLag() const;
+    int32 GetLastDrainProcessedTransitionCount() const;
+
+    void Enqueue( FMSMissionTransition && transition );
+
+    // Processes the pending transitions, highest priority first, until the queues are empty or budget_seconds is spent, if greater than 0.
+    // At least one transition is processed, so the queues always progress. Does nothing if the queues are already being drained
+    void Drain( TFunctionRef< void( const FMSMissionTransition & ) > processor, double budget_seconds = 0.0 );
+    void Reset();
+
+private:
+    UPROPERTY()
+    FMSMissionTransitionQueue Queues[ static_cast< uint8 >( EMSMissionTransitionPriority::Count ) ];
+
+    int32 PendingTransitionCount;
+    int32 MaxPendingTransitionCount;
+    uint32 ProcessedTransitionCount;
+    double LastDrainMaxLag;
+    int32 LastDrainProcessedTransitionCount;
+    bool bIsDraining;
+};
+
+FORCEINLINE bool FMSMissionTransitionQueue::IsEmpty() const
+{
+    return FirstIndex >= Transitions.Num();
+}
+
+FORCEINLINE int32 FMSMissionTransitionQueue::Num() const
+{
+    return Transitions.Num() - FirstIndex;
+}
+
+FORCEINLINE bool FMSMissionScheduler::IsDraining() const
+{
+    return bIsDraining;
+}
+
+FORCEINLINE int32 FMSMissionScheduler::GetPendingTransitionCount() const
+{
+    return PendingTransitionCount;
+}
+
+FORCEINLINE int32 FMSMissionScheduler::GetMaxPendingTransitionCount() const
+{
+    return MaxPendingTransitionCount;
+}
+
+FORCEINLINE uint32 FMSMissionScheduler::GetProcessedTransitionCount() const
+{
+    return ProcessedTransitionCount;
+}
+
+FORCEINLINE double FMSMissionScheduler::GetLastDrainMaxLag() const
+{
+    return LastDrainMaxLag;
+}
+
+FORCEINLINE int32 FMSMissionScheduler::GetLastDrainProcessedTransitionCount() const
+{
+    return LastDrainProcessedTransitionCount;
+}
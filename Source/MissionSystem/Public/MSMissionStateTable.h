@@ -0,0 +1,149 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+enum class EMSState : uint8
+{
+    Active,
+    Cancelled,
+    Complete
+};
+
+/* Stores the state of missions or objectives, packed in 2 bits per entry.
+ The first entries are bound to the IDs of the mission graph: their index is the index of the graph, and the table does not store their GUID.
+ Missions and objectives which are not in the graph are added after them, with their GUID, and keep their index for the lifetime of the table.
+ */
+class MISSIONSYSTEM_API FMSMissionStateTable
+{
+public:
+    using FFindBoundIndex = TFunction< int32( const FGuid & ) >;
+
+    int32 Num() const;
+    bool IsEmpty() const;
+
+    // Number of entries which have a state. Entries can exist without a state when indices are assigned in advance
+    int32 GetStateCount() const;
+
+    // Number of entries indexed by the mission graph. Can be larger than the bound IDs while a loaded table waits for its graph
+    int32 GetBoundCount() const;
+    bool HasId( int32 index ) const;
+    const FGuid & GetId( int32 index ) const;
+
+    int32 FindIndex( const FGuid & id ) const;
+    int32 FindOrAddIndex( const FGuid & id );
+
+    TOptional< EMSState > GetState( int32 index ) const;
+    bool HasState( int32 index, EMSState state ) const;
+    bool IsFinished( int32 index ) const;
+    void SetState( int32 index, EMSState state );
+    void ClearState( int32 index );
+
+    // Gives the first entries the indices of ids, which must outlive the binding, and moves the entries already stored for these IDs.
+    // find_bound_index returns the index of an ID in ids, or INDEX_NONE. The entries loaded before the table was bound keep their index
+    void Bind( TConstArrayView< FGuid > ids, FFindBoundIndex find_bound_index );
+
+    // Clears the states of the entries loaded with the indices of a graph which is not bound, when they do not match the graph to bind
+    void ClearUnboundStates();
+
+    // Removes all the entries. The table stays bound
+    void Reset();
+    SIZE_T GetAllocatedSize() const;
+
+    // Writes the states of the entries indexed by the graph, 2 bits each and without their GUID, then the entries which are not in the graph and
+    // have a state, with their GUID. saved_indices maps the table indices to the saved indices when saving, and the saved indices to the
+    // table indices when loading
+    void SerializeIndexed( FArchive & archive, TArray< int32 > & saved_indices );
+
+    // Only writes the entries which have a state, with their GUID and their packed state. Entries without a state are dropped, and the others
+    // are given new dense indices in the same order. compact_indices maps the table indices to the saved indices when saving, and the saved
+    // indices to the table indices when loading
+    void SerializeCompact( FArchive & archive, TArray< int32 > & compact_indices );
+
+    // Layout of the DenseStateTables and ActiveMissionIds versions of the history : the GUID of each entry, and its state packed in 32 bits words
+    friend FArchive & operator<<( FArchive & archive, FMSMissionStateTable & table );
+
+private:
+    static constexpr uint32 BitsPerState = 2;
+    static constexpr uint32 StatesPerWord = 32 / BitsPerState;
+    static constexpr uint32 StatesPerByte = 8 / BitsPerState;
+    static constexpr uint32 StateMask = ( 1 << BitsPerState ) - 1;
+
+    // 0 is reserved for entries which have no state. Other values are the state + 1
+    uint32 GetPackedState( int32 index ) const;
+    void SetPackedState( int32 index, uint32 packed_state );
+    void SetBoundCount( int32 bound_count );
+
+    // Owned by the mission graph
+    TConstArrayView< FGuid > BoundIds;
+    FFindBoundIndex FindBoundIndex;
+    int32 BoundCount = 0;
+
+    // Entries which are not in the graph, from BoundCount
+    TArray< FGuid > ExtraIds;
+    TMap< FGuid, int32 > ExtraIndicesById;
+
+    TArray< uint32 > PackedStates;
+    int32 StateCount = 0;
+};
+
+FORCEINLINE int32 FMSMissionStateTable::Num() const
+{
+    return BoundCount + ExtraIds.Num();
+}
+
+FORCEINLINE bool FMSMissionStateTable::IsEmpty() const
+{
+    return Num() == 0;
+}
+
+FORCEINLINE int32 FMSMissionStateTable::GetStateCount() const
+{
+    return StateCount;
+}
+
+FORCEINLINE int32 FMSMissionStateTable::GetBoundCount() const
+{
+    return BoundCount;
+}
+
+FORCEINLINE bool FMSMissionStateTable::HasId( const int32 index ) const
+{
+    return index < BoundCount ? BoundIds.IsValidIndex( index ) : ExtraIds.IsValidIndex( index - BoundCount );
+}
+
+FORCEINLINE const FGuid & FMSMissionStateTable::GetId( const int32 index ) const
+{
+    return index < BoundCount ? BoundIds[ index ] : ExtraIds[ index - BoundCount ];
+}
+
+FORCEINLINE uint32 FMSMissionStateTable::GetPackedState( const int32 index ) const
+{
+    if ( index < 0 || index >= Num() )
+    {
+        return 0;
+    }
+
+    return ( PackedStates[ index / StatesPerWord ] >> ( ( index % StatesPerWord ) * BitsPerState ) ) & StateMask;
+}
+
+FORCEINLINE TOptional< EMSState > FMSMissionStateTable::GetState( const int32 index ) const
+{
+    const auto packed_state = GetPackedState( index );
+
+    if ( packed_state == 0 )
+    {
+        return {};
+    }
+
+    return static_cast< EMSState >( packed_state - 1 );
+}
+
+FORCEINLINE bool FMSMissionStateTable::HasState( const int32 index, const EMSState state ) const
+{
+    return GetPackedState( index ) == static_cast< uint32 >( state ) + 1;
+}
+
+FORCEINLINE bool FMSMissionStateTable::IsFinished( const int32 index ) const
+{
+    return GetPackedState( index ) > static_cast< uint32 >( EMSState::Active ) + 1;
+}
@@ -1,16 +1,30 @@
 #pragma once
 
+#include "MSActionLatencyTracker.h"
+#include "MSActionPool.h"
 #include "MSMission.h"
 #include "MSMissionData.h"
+#include "MSMissionEvents.h"
 #include "MSMissionHistory.h"
+#include "MSMissionPrefetcher.h"
+#include "MSMissionScheduler.h"
+#include "MSObjectivePool.h"
+#include "MSObjectiveTagMatcher.h"
+#include "MSObserverRegistry.h"
+#include "MSReplicatedMissionState.h"
+#include "MSRuntimeCounters.h"
 
 #include <Components/ActorComponent.h>
 #include <CoreMinimal.h>
+#include <Tasks/Task.h>
+
+#include <atomic>
 
 #include "MSMissionSystemComponent.generated.h"
 
 class UMSViewModel;
 class UMSMissionData;
+class UMSMissionGraph;
 
 DECLARE_DYNAMIC_DELEGATE_OneParam( FMSMissionSystemMissionStartedDynamicDelegate, const UMSMissionData *, MissionData );
 DECLARE_DELEGATE_OneParam( FMSMissionSystemMissionStartedDelegate, const UMSMissionData * MissionData );
@@ -28,6 +42,10 @@ DECLARE_DYNAMIC_DELEGATE_TwoParams( FMSMissionSystemMissionObjectiveEndedDynamic
 DECLARE_DELEGATE_TwoParams( FMSMissionSystemMissionObjectiveEndedDelegate, TSubclassOf< UMSMissionObjective > MissionObjective, bool WasCancelled );
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams( FMSMissionSystemMissionObjectiveEndedMulticastDynamicDelegate, const UMSMissionData *, MissionData, TSubclassOf< UMSMissionObjective >, MissionObjective, bool, WasCancelled );
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam( FMSMissionSystemEventsDispatchedMulticastDynamicDelegate, const TArray< FMSMissionEvent > &, Events );
+
+DECLARE_EVENT_ThreeParams( UMSMissionSystemComponent, FMSOnReplicatedMissionStateChangedEvent, const FGuid & Id, bool IsObjective, TOptional< EMSState > State );
+
 /* This component manages the missions and their objectives for a player
  The best actor to put this component on would be the player controller
  */
@@ -41,6 +59,18 @@ public:
     explicit UMSMissionSystemComponent( const FObjectInitializer & object_initializer = FObjectInitializer::Get() );
 
     const FMSMissionHistory & GetMissionHistory() const;
+    const UMSMissionGraph * GetMissionGraph() const;
+    const FMSObjectivePool & GetObjectivePool() const;
+    const FMSActionPool & GetActionPool() const;
+    const FMSMissionScheduler & GetScheduler() const;
+    const FMSMissionPrefetcher & GetPrefetcher() const;
+    const FMSRuntimeCounters & GetRuntimeCounters() const;
+    const FMSActionLatencyTracker & GetActionLatencyTracker() const;
+    bool IsTimeSlicingTransitions() const;
+    const FMSReplicatedMissionState & GetReplicatedState() const;
+
+    // Client only. Broadcast when the state of a mission or of an objective replicated by the server has been applied to the history
+    FMSOnReplicatedMissionStateChangedEvent & OnReplicatedMissionStateChanged();
 
     UFUNCTION( BlueprintCallable, BlueprintPure = false, meta = ( ExpandBoolAsExecs = "ReturnValue" ) )
     bool HasDataInHistory() const;
@@ -72,27 +102,80 @@ public:
     UFUNCTION( BlueprintCallable, BlueprintAuthorityOnly, Category = "Mission System" )
     bool CompleteObjective( UMSMissionData * mission_data, TSubclassOf< UMSMissionObjective > mission_objective_class );
 
+    // Saves the history to file_path. Only the states which changed since the last save are appended to a journal next to the file,
+    // until the journal holds MaxHistoryJournalEntries states, at which point the whole history is saved again and the journal is deleted
+    UFUNCTION( BlueprintCallable, BlueprintAuthorityOnly, Category = "Mission System" )
+    bool SaveHistory( const FString & file_path );
+
+    // Same as SaveHistory, but only copies the history or encodes its changes on the game thread. The encoding and the compression of
+    // the snapshot, and the file writes, run on a background task. Saves are written in the order they are requested
+    UE::Tasks::TTask< bool > SaveHistoryAsync( const FString & file_path );
+
+    // Loads the history saved with SaveHistory, and replays the changes of its journal
+    UFUNCTION( BlueprintCallable, BlueprintAuthorityOnly, Category = "Mission System" )
+    bool LoadHistory( const FString & file_path );
+
     void WhenMissionStartsOrIsActive( UMSMissionData * mission_data, const FMSMissionSystemMissionStartedDelegate & when_mission_starts );
     void WhenMissionEnds( UMSMissionData * mission_data, const FMSMissionSystemMissionEndedDelegate & when_mission_ends );
 
     void WhenMissionObjectiveStartsOrIsActive( const TSubclassOf< UMSMissionObjective > & mission_objective_class, const FMSMissionSystemMissionObjectiveStartedDelegate & when_mission_objective_starts );
     void WhenMissionObjectiveEnds( const TSubclassOf< UMSMissionObjective > & mission_objective_class, const FMSMissionSystemMissionObjectiveEndedDelegate & when_mission_objective_ends );
 
-#if !( UE_BUILD_SHIPPING || UE_BUILD_TEST )
-    void DumpActiveMissions( FOutputDevice & output_device );
+    // Prints the runtime counters, the pending observers, the size of the history and the number of view models. Available in all the builds
+    void DumpStats( FOutputDevice & output_device ) const;
+
+    // Completes the active objectives whose tags contain any of the tags to ignore, and the objectives which start later without executing them.
+    // Available in all the builds, so automation runs can filter the objectives
     void IgnoreObjectivesWithTags( const TArray< FString > & tags );
     void ClearIgnoreObjectivesTags();
     bool MustObjectiveBeIgnored( const UMSMissionObjective * objective ) const;
+
+#if !( UE_BUILD_SHIPPING || UE_BUILD_TEST )
+    void DumpActiveMissions( FOutputDevice & output_device );
 #endif
 
+    void TickComponent( float delta_time, ELevelTick tick_type, FActorComponentTickFunction * this_tick_function ) override;
+
+    // Dispatches the events buffered when bDeferEventDispatch is set. Called at the end of the frame
+    void FlushEvents();
+
     void Serialize( FArchive & archive ) override;
+    void GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & out_lifetime_props ) const override;
     void ClearMissionHistory();
 
+    // Called by the replicated state on the clients
+    void OnReplicatedStateChanged( const FMSReplicatedMissionStateItem & item );
+    void OnReplicatedStateRemoved( const FMSReplicatedMissionStateItem & item );
+
+    // All the transitions of the missions and of their objectives go through the scheduler, so they are processed iteratively and in order
+    void ScheduleTransition( FMSMissionTransition && transition );
+
+    // Returns an objective outered to the mission, taken from the pool when bPoolObjectives is set
+    UMSMissionObjective * AcquireObjective( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective_class );
+
+    // Objectives are returned to the pool on the next tick, as they can be released while their actions are still on the callstack
+    void ReleaseObjective( UMSMissionObjective * objective );
+
+    // Returns an instance of action_template, from the pool unless MissionSystem.PoolActions is false
+    UMSMissionAction * AcquireAction( const UMSMissionAction * action_template );
+
+    // Like objectives, actions are returned to the pool on the next tick
+    void ReleaseAction( UMSMissionAction * action );
+
+    // Called by the action executors, to update the runtime counters and to measure the latency of the actions
+    void RecordActionStarted( const UMSMissionAction & action );
+    void RecordActionFinished( const UMSMissionAction & action );
+    void RecordActionCancelled( const UMSMissionAction & action );
+
+    // Returns the released objectives and actions to their pools. Called on the next tick after a release
+    void FlushReleasedObjects();
+
     UFUNCTION( BlueprintCallable )
     void TryResumeMissionFromHistory();
 
 protected:
     void OnRegister() override;
+    void OnUnregister() override;
 
     UFUNCTION( BlueprintCallable, BlueprintAuthorityOnly, Category = "Mission System", meta = ( DisplayName = "When Mission Starts or Is Active", AutoCreateRefTerm = "when_mission_starts" ) )
     void K2_WhenMissionStartsOrIsActive( UMSMissionData * mission_data, FMSMissionSystemMissionStartedDynamicDelegate when_mission_starts );
@@ -107,34 +190,19 @@ protected:
     void K2_WhenMissionObjectiveEnds( TSubclassOf< UMSMissionObjective > mission_objective, FMSMissionSystemMissionObjectiveEndedDynamicDelegate when_mission_objective_ends );
 
 private:
-    struct FMissionStartObserver
-    {
-        UMSMissionData * MissionData;
-        FMSMissionSystemMissionStartedDelegate Callback;
-    };
-
-    struct FMissionEndObserver
-    {
-        UMSMissionData * MissionData;
-        FMSMissionSystemMissionEndedDelegate Callback;
-    };
-
-    struct FMissionObjectiveStartObserver
-    {
-        TSubclassOf< UMSMissionObjective > MissionObjective;
-        FMSMissionSystemMissionObjectiveStartedDelegate Callback;
-    };
-
-    struct FMissionObjectiveEndObserver
-    {
-        TSubclassOf< UMSMissionObjective > MissionObjective;
-        FMSMissionSystemMissionObjectiveEndedDelegate Callback;
-    };
-
+    UMSMission * GetActiveMission( const FGuid & mission_id ) const;
+    void DrainTransitions( double budget_seconds );
+    void ProcessTransition( const FMSMissionTransition & transition );
     UMSMission * TryCreateMissionFromData( UMSMissionData * mission_data );
     UMSMission * CreateMissionFromData( UMSMissionData * mission_data );
     void StartMission( UMSMission * mission );
     void StartNextMissions( const UMSMissionData * mission_data );
+    void StartNextMissions( int32 mission_index );
+    void PrefetchNextMissions( const UMSMissionData * mission_data );
+    void CancelMissions( int32 mission_index );
+
+    // Releases the prefetched assets of a mission which is cancelled before it starts, unless the mission waits for them to start
+    void ReleasePrefetchedMission( const FSoftObjectPath & mission_path );
     void OnMissionEnded( UMSMission * mission, bool was_cancelled );
     void OnMissionObjectiveStarted( const TSubclassOf< UMSMissionObjective > & objective, UMSMission * mission );
     void OnMissionObjectiveEnded( const TSubclassOf< UMSMissionObjective > & objective, bool was_cancelled, UMSMission * mission );
@@ -142,13 +210,38 @@ private:
     void BroadcastOnMissionEnded( UMSMission * mission, bool was_cancelled );
     void BroadcastOnMissionObjectiveStarted( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective );
     void BroadcastOnMissionObjectiveEnded( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective, bool was_cancelled );
+    void DispatchEvent( FMSMissionEvent && event );
+    void DispatchEventNow( const FMSMissionEvent & event );
+    bool IsReplicatingMissionState() const;
+    void ReplicateMissionState( UMSMissionData * mission_data );
+    void ReplicateObjectiveState( const TSubclassOf< UMSMissionObjective > & objective );
+    void RebuildReplicatedState();
+    void ApplyReplicatedState( const FMSReplicatedMissionStateItem & item, TOptional< EMSState > state );
+
+    // Adds the counters of the component to the MissionSystem category of the CSV profiler, at the end of each frame of a capture
+    void RecordCsvStats();
+
+    // Warns about the actions which did not call FinishExecute within MissionSystem.ActionDeadline. Called every second while actions are executing
+    void CheckActionDeadlines();
+
+    // Schedules FlushReleasedObjects on the next tick, before the first object is released
+    void ScheduleFlushReleasedObjects();
 
     UPROPERTY()
     TArray< UMSMission * > ActiveMissions;
 
+    // Index of ActiveMissions by mission ID, to avoid linear searches when looking up an active mission
+    TMap< FGuid, UMSMission * > ActiveMissionsById;
+
     UPROPERTY()
     TArray< FString > TagsToIgnoreForObjectives;
 
+    // TagsToIgnoreForObjectives compiled, rebuilt each time the list changes or is loaded
+    FMSObjectiveTagMatcher ObjectiveTagMatcher;
+
+    // :NOTE: Mutable, as it is only reused by MustObjectiveBeIgnored to gather the tags of the objectives without allocating
+    mutable FGameplayTagContainer ObjectiveTagsBuffer;
+
     UPROPERTY( BlueprintAssignable, meta = ( AllowPrivateAccess = true ) )
     FMSMissionSystemMissionStartedMulticastDynamicDelegate OnMissionStartedDelegate;
 
@@ -161,6 +254,10 @@ private:
     UPROPERTY( BlueprintAssignable, meta = ( AllowPrivateAccess = true ) )
     FMSMissionSystemMissionObjectiveEndedMulticastDynamicDelegate OnMissionObjectiveEndedDelegate;
 
+    // Batched form of the mission and objective events. Broadcast once per frame with all the events of the frame when bDeferEventDispatch is set, once per event otherwise
+    UPROPERTY( BlueprintAssignable, meta = ( AllowPrivateAccess = true ) )
+    FMSMissionSystemEventsDispatchedMulticastDynamicDelegate OnMissionEventsDispatchedDelegate;
+
     UPROPERTY( Transient, BlueprintReadOnly, meta = ( AllowPrivateAccess = true ) )
     TObjectPtr< UMSViewModel > ViewModel;
 
@@ -170,6 +267,10 @@ private:
     UPROPERTY( EditDefaultsOnly, meta = ( EditCondition = "bCreateViewModel" ) )
     uint8 bRegisterViewModel : 1;
 
+    // When set, the view models of the missions and of their objectives are only created once a widget reads the active missions of the view model
+    UPROPERTY( EditDefaultsOnly, meta = ( EditCondition = "bCreateViewModel" ) )
+    uint8 bCreateViewModelsLazily : 1;
+
     UPROPERTY( EditDefaultsOnly, meta = ( EditCondition = "bCreateViewModel && bRegisterViewModel" ) )
     FName ViewModelContextName;
 
@@ -179,14 +280,151 @@ private:
     UPROPERTY( EditDefaultsOnly, meta = ( EditCondition = "bTryResumeMissionFromHistory" ) )
     TObjectPtr< UMSMissionData > FirstMissionToStart;
 
-    TArray< FMissionStartObserver > MissionStartObservers;
-    TArray< FMissionEndObserver > MissionEndObservers;
-    TArray< FMissionObjectiveStartObserver > MissionObjectiveStartObservers;
-    TArray< FMissionObjectiveEndObserver > MissionObjectiveEndObservers;
+    // When set, missions are started and chained using this compiled graph instead of the mission data
+    UPROPERTY( EditDefaultsOnly )
+    TObjectPtr< UMSMissionGraph > MissionGraph;
+
+    // Number of next mission edges the data and the objectives of the next missions are loaded ahead of time when a mission starts. 0 disables the prefetch
+    UPROPERTY( EditDefaultsOnly, Category = "Loading", meta = ( ClampMin = 0 ) )
+    int32 PrefetchDepth;
+
+    FMSMissionPrefetcher Prefetcher;
+
+    // Missions started once the prefetcher has loaded them. Their assets are released when their start transition is processed, whether they start or not
+    TSet< FSoftObjectPath > MissionsToStartWhenLoaded;
+
+    // When set, the objectives of ended missions are reset and reused by the next missions instead of being garbage collected
+    UPROPERTY( EditDefaultsOnly, Category = "Pooling" )
+    uint8 bPoolObjectives : 1;
+
+    UPROPERTY( EditDefaultsOnly, Category = "Pooling", meta = ( EditCondition = "bPoolObjectives", ClampMin = 1 ) )
+    int32 MaxPooledObjectivesPerClass;
+
+    UPROPERTY( Transient )
+    FMSObjectivePool ObjectivePool;
+
+    UPROPERTY( Transient )
+    TArray< TObjectPtr< UMSMissionObjective > > ReleasedObjectives;
+
+    UPROPERTY( EditDefaultsOnly, Category = "Pooling", meta = ( ClampMin = 1 ) )
+    int32 MaxPooledActionsPerTemplate;
+
+    UPROPERTY( Transient )
+    FMSActionPool ActionPool;
+
+    UPROPERTY( Transient )
+    TArray< TObjectPtr< UMSMissionAction > > ReleasedActions;
+
+    UPROPERTY( Transient )
+    FMSMissionScheduler Scheduler;
+
+    // When set, the mission and objective events are buffered and dispatched in order at the end of the frame, to the delegates, the observers and the view model
+    UPROPERTY( EditDefaultsOnly, Category = "Events" )
+    uint8 bDeferEventDispatch : 1;
+
+    UPROPERTY( Transient )
+    TArray< FMSMissionEvent > PendingEvents;
+
+    FDelegateHandle EndFrameDelegateHandle;
+
+    // When set, the transitions of the missions, objectives and actions are queued and processed by the tick of the component, within TimeSliceBudget.
+    // Missions started with StartMission are then only active after the next tick
+    UPROPERTY( EditDefaultsOnly, Category = "Scheduling" )
+    uint8 bTimeSliceTransitions : 1;
+
+    UPROPERTY( EditDefaultsOnly, Category = "Scheduling", meta = ( EditCondition = "bTimeSliceTransitions", ClampMin = 0.1, Units = "ms" ) )
+    float TimeSliceBudget;
+
+    // When set, the states of the missions and objectives of the history are replicated to the owning client, which only receives the states which changed
+    UPROPERTY( EditDefaultsOnly, Category = "Replication" )
+    uint8 bReplicateMissionState : 1;
+
+    UPROPERTY( Replicated )
+    FMSReplicatedMissionState ReplicatedState;
+
+    FMSOnReplicatedMissionStateChangedEvent OnReplicatedMissionStateChangedEvent;
+
+    // Number of states SaveHistory appends to the journal before it saves the whole history again
+    UPROPERTY( EditDefaultsOnly, Category = "Saving", meta = ( ClampMin = 0 ) )
+    int32 MaxHistoryJournalEntries;
+
+    // Identifies the history last saved or loaded by SaveHistory and LoadHistory. Journal entries of other snapshots are ignored when loading
+    FGuid HistorySnapshotId;
+
+    // File of HistorySnapshotId. Saving the history to another file starts with a snapshot
+    FString HistorySnapshotPath;
+    int32 HistoryJournalEntryCount;
+
+    // Last save launched by SaveHistoryAsync, which the next save waits for
+    UE::Tasks::TTask< bool > PendingHistorySave;
+
+    // Set by a background save which failed, so the next save writes the whole history
+    TSharedRef< std::atomic< bool >, ESPMode::ThreadSafe > HistorySaveFailed;
+
+    FMSRuntimeCounters RuntimeCounters;
+    FDelegateHandle CsvEndFrameDelegateHandle;
+
+    FMSActionLatencyTracker ActionLatencyTracker;
+    FTimerHandle ActionDeadlineTimerHandle;
+
+    TMSObserverRegistry< const UMSMissionData *, FMSMissionSystemMissionStartedDelegate > MissionStartObservers;
+    TMSObserverRegistry< const UMSMissionData *, FMSMissionSystemMissionEndedDelegate > MissionEndObservers;
+    TMSObserverRegistry< const UClass *, FMSMissionSystemMissionObjectiveStartedDelegate > MissionObjectiveStartObservers;
+    TMSObserverRegistry< const UClass *, FMSMissionSystemMissionObjectiveEndedDelegate > MissionObjectiveEndObservers;
     FMSMissionHistory MissionHistory;
 };
 
 FORCEINLINE const FMSMissionHistory & UMSMissionSystemComponent::GetMissionHistory() const
 {
     return MissionHistory;
+}
+
+FORCEINLINE const UMSMissionGraph * UMSMissionSystemComponent::GetMissionGraph() const
+{
+    return MissionGraph;
+}
+
+FORCEINLINE const FMSObjectivePool & UMSMissionSystemComponent::GetObjectivePool() const
+{
+    return ObjectivePool;
+}
+
+FORCEINLINE const FMSActionPool & UMSMissionSystemComponent::GetActionPool() const
+{
+    return ActionPool;
+}
+
+FORCEINLINE const FMSMissionScheduler & UMSMissionSystemComponent::GetScheduler() const
+{
+    return Scheduler;
+}
+
+FORCEINLINE const FMSMissionPrefetcher & UMSMissionSystemComponent::GetPrefetcher() const
+{
+    return Prefetcher;
+}
+
+FORCEINLINE const FMSRuntimeCounters & UMSMissionSystemComponent::GetRuntimeCounters() const
+{
+    return RuntimeCounters;
+}
+
+FORCEINLINE const FMSActionLatencyTracker & UMSMissionSystemComponent::GetActionLatencyTracker() const
+{
+    return ActionLatencyTracker;
+}
+
+FORCEINLINE bool UMSMissionSystemComponent::IsTimeSlicingTransitions() const
+{
+    return bTimeSliceTransitions;
+}
+
+FORCEINLINE const FMSReplicatedMissionState & UMSMissionSystemComponent::GetReplicatedState() const
+{
+    return ReplicatedState;
+}
+
+FORCEINLINE FMSOnReplicatedMissionStateChangedEvent & UMSMissionSystemComponent::OnReplicatedMissionStateChanged()
+{
+    return OnReplicatedMissionStateChangedEvent;
 }
\ No newline at end of file
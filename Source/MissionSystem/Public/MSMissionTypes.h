@@ -5,6 +5,7 @@
 #include "MSMissionTypes.generated.h"
 
 class UMSMissionAction;
+class UMSMissionSystemComponent;
 
 USTRUCT()
 struct MISSIONSYSTEM_API FMSActionExecutor
@@ -14,10 +15,23 @@ struct MISSIONSYSTEM_API FMSActionExecutor
 public:
     const TArray< UMSMissionAction * > & GetInstancedActions() const;
 
-    void Initialize( UObject * action_owner, const TArray< UMSMissionAction * > & action_classes, TFunction< void() > callback );
-    void Execute();
+    // Instantiates the action templates through the action pool of the mission system component which owns action_owner.
+    // The templates instanced in action_owner are only used by it, and are executed without a copy
+    void Initialize( UObject * action_owner, const TArray< UMSMissionAction * > & action_templates, TFunction< void() > callback );
+
+    // With hold_barrier_actions, the actions flagged as pipeline barriers are not executed until ExecuteBarrierActions is called
+    void Execute( bool hold_barrier_actions = false );
+    void ExecuteBarrierActions();
+
+    // Actions which were executed and did not call FinishExecute yet
+    bool HasExecutingActions() const;
+
+    // Returns the instanced actions to the action pool. The actions which were executed and did not finish are not pooled
+    void Release();
+    void Reset();
 
 private:
+    void ExecuteAction( UMSMissionAction * action );
     void OnActionExecuted( UMSMissionAction * action );
     void TryExecuteCallback();
 
@@ -27,7 +41,12 @@ private:
     UPROPERTY()
     TArray< UMSMissionAction * > PendingActions;
 
+    // Pending actions which wait for ExecuteBarrierActions
+    UPROPERTY()
+    TArray< UMSMissionAction * > HeldBarrierActions;
+
     TWeakObjectPtr< UObject > Outer;
+    TWeakObjectPtr< UMSMissionSystemComponent > Component;
 
     TFunction< void() > Callback;
 };
@@ -35,4 +54,9 @@ private:
 FORCEINLINE const TArray< UMSMissionAction * > & FMSActionExecutor::GetInstancedActions() const
 {
     return InstancedActions;
+}
+
+FORCEINLINE bool FMSActionExecutor::HasExecutingActions() const
+{
+    return PendingActions.Num() > HeldBarrierActions.Num();
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+struct FMSMissionObjectiveData;
+
+/* Dependencies between the objectives of a mission data, compiled when the mission data is loaded or saved.
+ An objective with Prerequisites depends on them. Any other objective depends on the objectives of the previous parallel group,
+ so missions without prerequisites keep running their objectives in the order of the list. An objective which is a prerequisite of an objective
+ earlier in the list depends on nothing, as the previous group could wait for it.
+ The objectives are indexed like the Objectives array of the mission data. The dependents are stored in a flat array of ranges,
+ so a mission only has to decrement the counters of the dependents of an objective which ends to know which objectives can start.
+ */
+class MISSIONSYSTEM_API FMSObjectiveDependencies
+{
+public:
+    int32 GetObjectiveCount() const;
+    TConstArrayView< int32 > GetTopologicalOrder() const;
+    TConstArrayView< int32 > GetDependencyCounts() const;
+    TConstArrayView< int32 > GetDependents( int32 objective_index ) const;
+
+    // Returns false when the prerequisites contain a cycle. The prerequisites are then ignored, and the objectives run in the order of the list
+    bool Build( TConstArrayView< FMSMissionObjectiveData > objectives );
+
+private:
+    // Fills the prerequisites of each objective. Without use_prerequisites, all the objectives depend on the previous parallel group
+    static void GatherDependencies( TConstArrayView< FMSMissionObjectiveData > objectives, bool use_prerequisites, TArray< TArray< int32 > > & dependencies );
+    bool Sort( const TArray< TArray< int32 > > & dependencies );
+
+    TArray< int32 > TopologicalOrder;
+    TArray< int32 > DependencyCounts;
+
+    // Range in Dependents of each objective, plus the end of the last range
+    TArray< int32 > FirstDependents;
+    TArray< int32 > Dependents;
+};
+
+FORCEINLINE int32 FMSObjectiveDependencies::GetObjectiveCount() const
+{
+    return DependencyCounts.Num();
+}
+
+FORCEINLINE TConstArrayView< int32 > FMSObjectiveDependencies::GetTopologicalOrder() const
+{
+    return TopologicalOrder;
+}
+
+FORCEINLINE TConstArrayView< int32 > FMSObjectiveDependencies::GetDependencyCounts() const
+{
+    return DependencyCounts;
+}
+
+FORCEINLINE TConstArrayView< int32 > FMSObjectiveDependencies::GetDependents( const int32 objective_index ) const
+{
+    return MakeArrayView( Dependents ).Slice( FirstDependents[ objective_index ], FirstDependents[ objective_index + 1 ] - FirstDependents[ objective_index ] );
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Templates/SubclassOf.h>
+
+#include "MSObjectivePool.generated.h"
+
+class UMSMissionObjective;
+
+USTRUCT()
+struct FMSPooledObjectives
+{
+    GENERATED_USTRUCT_BODY()
+
+    UPROPERTY()
+    TArray< TObjectPtr< UMSMissionObjective > > Objectives;
+};
+
+/* Keeps the objectives of finished missions, per class, to reuse them instead of creating new objects */
+USTRUCT()
+struct MISSIONSYSTEM_API FMSObjectivePool
+{
+    GENERATED_USTRUCT_BODY()
+
+public:
+    FMSObjectivePool();
+
+    uint32 GetHitCount() const;
+    uint32 GetMissCount() const;
+    int32 GetPooledObjectiveCount() const;
+
+    // Returns an objective from the pool, moved to the given outer, if one is available, or creates a new one with the given outer
+    UMSMissionObjective * Acquire( UObject * outer, const TSubclassOf< UMSMissionObjective > & objective_class );
+
+    // Resets the objective, moves it to pool_outer so it does not keep its previous outer alive, and makes it available for Acquire.
+    // The objective is left to the garbage collector if the pool of its class is full
+    void Release( UMSMissionObjective * objective, UObject * pool_outer, int32 max_objectives_per_class );
+    void Reset();
+
+private:
+    UPROPERTY()
+    TMap< TObjectPtr< UClass >, FMSPooledObjectives > PooledObjectives;
+
+    uint32 HitCount;
+    uint32 MissCount;
+    int32 PooledObjectiveCount;
+};
+
+FORCEINLINE uint32 FMSObjectivePool::GetHitCount() const
+{
+    return HitCount;
+}
+
+FORCEINLINE uint32 FMSObjectivePool::GetMissCount() const
+{
+    return MissCount;
+}
+
+FORCEINLINE int32 FMSObjectivePool::GetPooledObjectiveCount() const
+{
+    return PooledObjectiveCount;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <GameplayTagContainer.h>
+
+/* Compiled list of the tokens used to ignore objectives, rebuilt each time the list changes.
+ A tag matches when it contains any of the tokens, ignoring the case. The tokens are searched in the tag names with a prefix trie, started at
+ each character of the name. The children of a tag used as a token contain its name, so they match without looking up the tag hierarchy.
+ The result is cached by tag name, so matching the objectives again does not search the names nor allocate any string.
+ */
+class MISSIONSYSTEM_API FMSObjectiveTagMatcher
+{
+public:
+    bool IsEmpty() const;
+
+    void Build( TConstArrayView< FString > tokens );
+    void Reset();
+
+    bool Matches( const FGameplayTagContainer & tags ) const;
+    bool MatchesTagName( FName tag_name ) const;
+
+private:
+    struct FNode
+    {
+        TCHAR Character = 0;
+        int32 FirstChild = INDEX_NONE;
+        int32 NextSibling = INDEX_NONE;
+        bool bIsTokenEnd = false;
+    };
+
+    void AddToken( const FString & token );
+    int32 FindChild( int32 node_index, TCHAR character ) const;
+    bool ContainsToken( FStringView text ) const;
+
+    // Lower case characters of the tokens. The root is the first node, and is only added when there are tokens
+    TArray< FNode > Nodes;
+
+    // :NOTE: Mutable, as it is only a cache of the searches done in the tag names
+    mutable TMap< FName, bool > CachedMatches;
+};
+
+FORCEINLINE bool FMSObjectiveTagMatcher::IsEmpty() const
+{
+    return Nodes.Num() == 0;
+}
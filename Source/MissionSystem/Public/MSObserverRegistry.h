@@ -0,0 +1,91 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/* Stores one-shot observers by key.
+ A broadcast only visits the observers registered for its key, and removes them once they have been executed.
+ */
+template < typename _KeyType_, typename _DelegateType_ >
+class TMSObserverRegistry
+{
+public:
+    int32 Num() const;
+
+    void Add( const _KeyType_ & key, const _DelegateType_ & delegate );
+
+    template < typename... _ArgumentTypes_ >
+    void Broadcast( const _KeyType_ & key, const _ArgumentTypes_ &... arguments );
+
+    // Removes all the observers bound to user_object, whatever their key
+    void RemoveAll( const void * user_object );
+    void Reset();
+
+private:
+    TMap< _KeyType_, TArray< _DelegateType_ > > Observers;
+    int32 ObserverCount = 0;
+};
+
+template < typename _KeyType_, typename _DelegateType_ >
+FORCEINLINE int32 TMSObserverRegistry< _KeyType_, _DelegateType_ >::Num() const
+{
+    return ObserverCount;
+}
+
+template < typename _KeyType_, typename _DelegateType_ >
+void TMSObserverRegistry< _KeyType_, _DelegateType_ >::Add( const _KeyType_ & key, const _DelegateType_ & delegate )
+{
+    auto & observers = Observers.FindOrAdd( key );
+
+    // Get rid of the observers whose object has been destroyed since they registered
+    ObserverCount -= observers.RemoveAllSwap( []( const _DelegateType_ & observer ) {
+        return !observer.IsBound();
+    } );
+
+    observers.Add( delegate );
+    ++ObserverCount;
+}
+
+template < typename _KeyType_, typename _DelegateType_ >
+template < typename... _ArgumentTypes_ >
+void TMSObserverRegistry< _KeyType_, _DelegateType_ >::Broadcast( const _KeyType_ & key, const _ArgumentTypes_ &... arguments )
+{
+    auto * found_observers = Observers.Find( key );
+
+    if ( found_observers == nullptr )
+    {
+        return;
+    }
+
+    // Detach the observers before executing them, so that callbacks can register new observers, even for the same key
+    const auto observers = MoveTemp( *found_observers );
+    Observers.Remove( key );
+    ObserverCount -= observers.Num();
+
+    for ( const auto & observer : observers )
+    {
+        observer.ExecuteIfBound( arguments... );
+    }
+}
+
+template < typename _KeyType_, typename _DelegateType_ >
+void TMSObserverRegistry< _KeyType_, _DelegateType_ >::RemoveAll( const void * user_object )
+{
+    for ( auto iterator = Observers.CreateIterator(); iterator; ++iterator )
+    {
+        ObserverCount -= iterator.Value().RemoveAllSwap( [ user_object ]( const _DelegateType_ & observer ) {
+            return observer.IsBoundToObject( user_object );
+        } );
+
+        if ( iterator.Value().IsEmpty() )
+        {
+            iterator.RemoveCurrent();
+        }
+    }
+}
+
+template < typename _KeyType_, typename _DelegateType_ >
+void TMSObserverRegistry< _KeyType_, _DelegateType_ >::Reset()
+{
+    Observers.Reset();
+    ObserverCount = 0;
+}
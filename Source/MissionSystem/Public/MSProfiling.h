@@ -0,0 +1,68 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+#include <Stats/Stats.h>
+#include <Trace/Trace.h>
+
+class UMSMissionAction;
+
+DECLARE_STATS_GROUP( TEXT( "MissionSystem" ), STATGROUP_MissionSystem, STATCAT_Advanced );
+
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Process Transition" ), STAT_MissionSystem_ProcessTransition, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Start Mission" ), STAT_MissionSystem_StartMission, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "End Mission" ), STAT_MissionSystem_EndMission, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Execute Objective" ), STAT_MissionSystem_ExecuteObjective, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Execute Actions" ), STAT_MissionSystem_ExecuteActions, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Dispatch Event" ), STAT_MissionSystem_DispatchEvent, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Flush Events" ), STAT_MissionSystem_FlushEvents, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Save History" ), STAT_MissionSystem_SaveHistory, STATGROUP_MissionSystem, MISSIONSYSTEM_API );
+
+#define MS_TRACE_ENABLED ( UE_TRACE_ENABLED && CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING )
+
+#if MS_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN( MissionSystemChannel, MISSIONSYSTEM_API );
+
+/* Outputs the mission system events to Unreal Insights, on the MissionSystem trace channel.
+ Start the game with -trace=default,MissionSystem, or use Trace.Enable MissionSystem, to record them.
+ Nothing is formatted or allocated while the channel is disabled.
+ */
+struct MISSIONSYSTEM_API FMSTrace
+{
+    static FString GetObjectName( const UObject * object );
+
+    // Name of the action class, followed by the name of the mission data or of the objective which holds the action template
+    static FString GetActionName( const UMSMissionAction * action );
+
+    static void OutputMissionStarted( const UObject * mission_data );
+    static void OutputMissionEnded( const UObject * mission_data, bool was_cancelled );
+    static void OutputObjectiveStarted( const UClass * objective_class );
+    static void OutputObjectiveEnded( const UClass * objective_class, bool was_cancelled );
+    static void OutputActionExecuted( const UMSMissionAction * action );
+    static void OutputActionFinished( const UMSMissionAction * action );
+
+    // Output when an action did not call FinishExecute before MissionSystem.ActionDeadline, and when it finally does
+    static void OutputActionPastDeadline( const UMSMissionAction * action, double latency );
+};
+
+// CPU scope of the MissionSystem channel
+#define MS_TRACE_SCOPE( ScopeName ) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR( "MissionSystem::" ScopeName, MissionSystemChannel )
+
+// CPU scope of the MissionSystem channel suffixed with NameExpression, so hitches can be attributed to a mission, an objective or an action.
+// NameExpression is only evaluated when the channel is enabled
+#define MS_TRACE_NAMED_SCOPE( ScopeName, NameExpression ) \
+    const auto PREPROCESSOR_JOIN( MSTraceScopeName, __LINE__ ) = UE_TRACE_CHANNELEXPR_IS_ENABLED( MissionSystemChannel ) ? FString::Printf( TEXT( "MissionSystem::%s %s" ), TEXT( ScopeName ), *( NameExpression ) ) : FString(); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL( *PREPROCESSOR_JOIN( MSTraceScopeName, __LINE__ ), MissionSystemChannel )
+
+#define MS_TRACE_EVENT( EventName, ... ) \
+    FMSTrace::Output##EventName( __VA_ARGS__ )
+
+#else
+
+#define MS_TRACE_SCOPE( ScopeName )
+#define MS_TRACE_NAMED_SCOPE( ScopeName, NameExpression )
+#define MS_TRACE_EVENT( EventName, ... )
+
+#endif
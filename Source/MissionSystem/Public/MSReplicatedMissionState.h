@@ -0,0 +1,118 @@
+#pragma once
+
+#include "MSMissionStateTable.h"
+
+#include <CoreMinimal.h>
+#include <Net/Serialization/FastArraySerializer.h>
+
+#include "MSReplicatedMissionState.generated.h"
+
+struct FMSMissionHistory;
+struct FMSReplicatedMissionState;
+class UMSMissionSystemComponent;
+
+/* The state of a mission or of an objective, as replicated to the owning client.
+ Entries are keyed by the dense index of the mission or objective in the history. The GUID is only sent for entries
+ which are not part of the mission graph, as the client can not resolve their index by itself
+ */
+USTRUCT()
+struct MISSIONSYSTEM_API FMSReplicatedMissionStateItem : public FFastArraySerializerItem
+{
+    GENERATED_USTRUCT_BODY()
+
+    FMSReplicatedMissionStateItem();
+
+    bool NetSerialize( FArchive & archive, UPackageMap * package_map, bool & out_success );
+
+    void PreReplicatedRemove( const FMSReplicatedMissionState & array_serializer );
+    void PostReplicatedAdd( const FMSReplicatedMissionState & array_serializer );
+    void PostReplicatedChange( const FMSReplicatedMissionState & array_serializer );
+
+    UPROPERTY()
+    FGuid Id;
+
+    UPROPERTY()
+    int32 Index;
+
+    UPROPERTY()
+    uint8 bIsObjective : 1;
+
+    // Set when Index is the index of the mission or objective in the mission graph, in which case Id is not replicated
+    UPROPERTY()
+    uint8 bIsInGraph : 1;
+
+    EMSState State;
+};
+
+template <>
+struct TStructOpsTypeTraits< FMSReplicatedMissionStateItem > : public TStructOpsTypeTraitsBase2< FMSReplicatedMissionStateItem >
+{
+    enum
+    {
+        WithNetSerializer = true
+    };
+};
+
+/* Mirrors the mission history of the server, so that only the missions and objectives whose state changed are sent to the client
+ */
+USTRUCT()
+struct MISSIONSYSTEM_API FMSReplicatedMissionState : public FFastArraySerializer
+{
+    GENERATED_USTRUCT_BODY()
+
+    FMSReplicatedMissionState();
+
+    void SetOwner( UMSMissionSystemComponent * owner );
+    UMSMissionSystemComponent * GetOwner() const;
+    const TArray< FMSReplicatedMissionStateItem > & GetItems() const;
+
+    // Server only. mission_index and objective_index are the indices in the tables of the history
+    void UpdateMission( const FMSMissionHistory & history, int32 mission_index );
+    void UpdateObjective( const FMSMissionHistory & history, int32 objective_index );
+
+    // Server only. Replaces all the entries by the states stored in the history, after it has been loaded or cleared
+    void Rebuild( const FMSMissionHistory & history );
+
+    bool NetDeltaSerialize( FNetDeltaSerializeInfo & delta_parameters );
+
+private:
+    void UpdateItem( const FMSMissionStateTable & table, int32 index, bool is_objective, int32 graph_count );
+
+    UPROPERTY()
+    TArray< FMSReplicatedMissionStateItem > Items;
+
+    // Index in Items of the entry of each mission and objective, by their index in the history. Not replicated
+    TArray< int32 > MissionItemIndices;
+    TArray< int32 > ObjectiveItemIndices;
+
+    UMSMissionSystemComponent * Owner;
+};
+
+template <>
+struct TStructOpsTypeTraits< FMSReplicatedMissionState > : public TStructOpsTypeTraitsBase2< FMSReplicatedMissionState >
+{
+    enum
+    {
+        WithNetDeltaSerializer = true
+    };
+};
+
+FORCEINLINE void FMSReplicatedMissionState::SetOwner( UMSMissionSystemComponent * owner )
+{
+    Owner = owner;
+}
+
+FORCEINLINE UMSMissionSystemComponent * FMSReplicatedMissionState::GetOwner() const
+{
+    return Owner;
+}
+
+FORCEINLINE const TArray< FMSReplicatedMissionStateItem > & FMSReplicatedMissionState::GetItems() const
+{
+    return Items;
+}
+
+FORCEINLINE bool FMSReplicatedMissionState::NetDeltaSerialize( FNetDeltaSerializeInfo & delta_parameters )
+{
+    return FFastArraySerializer::FastArrayDeltaSerialize< FMSReplicatedMissionStateItem, FMSReplicatedMissionState >( Items, delta_parameters, *this );
+}
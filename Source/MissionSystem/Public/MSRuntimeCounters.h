@@ -0,0 +1,17 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+/* Number of missions, objectives and actions a mission system component started and finished since it was created.
+ They only cost an increment, so they are updated in all the builds, to track the growth of long sessions
+ with MissionSystem.Stats and the MissionSystem category of the CSV profiler.
+ */
+struct FMSRuntimeCounters
+{
+    uint64 MissionsStarted = 0;
+    uint64 MissionsFinished = 0;
+    uint64 ObjectivesStarted = 0;
+    uint64 ObjectivesFinished = 0;
+    uint64 ActionsStarted = 0;
+    uint64 ActionsFinished = 0;
+};
@@ -9,30 +9,60 @@ class UMSMissionObjective;
 class UMSMission;
 class UMSObjectiveViewModel;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( FMSOnObjectiveViewModelAddedDelegate, UMSObjectiveViewModel *, ObjectiveViewModel, int32, Index );
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( FMSOnObjectiveViewModelRemovedDelegate, UMSObjectiveViewModel *, ObjectiveViewModel, int32, Index );
+
 UCLASS()
 class MISSIONSYSTEM_API UMSMissionViewModel final : public UMVVMViewModelBase
 {
     GENERATED_BODY()
 
 public:
+    UMSMissionViewModel();
+
     UMSMission * GetMission() const;
+    bool IsDirty() const;
 
     void Initialize( UMSMission * mission );
-    void SetObjectiveStarted( const TSubclassOf< UMSMissionObjective > & objective );
-    void SetObjectiveEnded( const TSubclassOf< UMSMissionObjective > & objective );
 
-private:
-    UPROPERTY( BlueprintReadOnly, EditAnywhere, FieldNotify, Category = "ViewModel", meta = ( AllowPrivateAccess ) )
-    FText Name;
+    // Returns the objective view models to the pool of the root view model. Called when the view model itself is returned to the pool
+    void Reset();
+
+    // These functions return true when ActiveObjectives changed. The field notification is only broadcast by FlushChanges
+    bool SetObjectiveStarted( const TSubclassOf< UMSMissionObjective > & objective );
+    bool SetObjectiveEnded( const TSubclassOf< UMSMissionObjective > & objective );
+    void FlushChanges();
 
+    // The name is read from the mission data when it is accessed, instead of being copied when the view model is initialized
+    UFUNCTION( BlueprintPure, FieldNotify, Category = "ViewModel" )
+    FText GetName() const;
+
+private:
     UPROPERTY( BlueprintReadOnly, FieldNotify, meta = ( AllowPrivateAccess ) )
     TArray< TObjectPtr< UMSObjectiveViewModel > > ActiveObjectives;
 
+    // Broadcast as soon as an objective is added to or removed from ActiveObjectives, so lists can be patched instead of rebuilt
+    UPROPERTY( BlueprintAssignable, meta = ( AllowPrivateAccess ) )
+    FMSOnObjectiveViewModelAddedDelegate OnObjectiveAdded;
+
+    UPROPERTY( BlueprintAssignable, meta = ( AllowPrivateAccess ) )
+    FMSOnObjectiveViewModelRemovedDelegate OnObjectiveRemoved;
+
     UPROPERTY( Transient )
     TObjectPtr< UMSMission > Mission;
+
+    UPROPERTY( Transient )
+    TMap< TObjectPtr< UClass >, TObjectPtr< UMSObjectiveViewModel > > ObjectiveViewModels;
+
+    bool bIsDirty;
 };
 
 FORCEINLINE UMSMission * UMSMissionViewModel::GetMission() const
 {
     return Mission;
-}
\ No newline at end of file
+}
+
+FORCEINLINE bool UMSMissionViewModel::IsDirty() const
+{
+    return bIsDirty;
+}
@@ -16,15 +16,19 @@ public:
     const TSubclassOf< UMSMissionObjective > & GetObjectiveClass() const;
 
     void Initialize( const TSubclassOf< UMSMissionObjective > & objective_class );
-    
-private:
-    UPROPERTY( BlueprintReadOnly, FieldNotify, Category = "ViewModel", meta = ( AllowPrivateAccess ) )
-    FText Name;
 
+    // Called when the view model is returned to the pool of the root view model
+    void Reset();
+
+    // The name is read from the objective class when it is accessed, instead of being copied when the view model is initialized
+    UFUNCTION( BlueprintPure, FieldNotify, Category = "ViewModel" )
+    FText GetName() const;
+
+private:
     TSubclassOf< UMSMissionObjective > ObjectiveClass;
 };
 
 FORCEINLINE const TSubclassOf< UMSMissionObjective > & UMSObjectiveViewModel::GetObjectiveClass() const
 {
     return ObjectiveClass;
-}
\ No newline at end of file
+}
@@ -9,21 +9,108 @@
 
 class UMSMission;
 class UMSMissionViewModel;
+class UMSObjectiveViewModel;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( FMSOnMissionViewModelAddedDelegate, UMSMissionViewModel *, MissionViewModel, int32, Index );
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( FMSOnMissionViewModelRemovedDelegate, UMSMissionViewModel *, MissionViewModel, int32, Index );
+
+/* Root view model of the mission system.
+ The changes of the missions and of their objectives are tracked, and the field notifications are broadcast once, at the end of the frame.
+ The Added / Removed delegates are broadcast immediately, for the lists which want to patch their entries instead of being rebuilt.
+ The mission and objective view models are recycled: do not keep a reference to them once they have been removed.
+ */
 UCLASS()
 class MISSIONSYSTEM_API UMSViewModel final : public UMVVMViewModelBase
 {
     GENERATED_BODY()
 
 public:
+    UMSViewModel();
+
+    void BeginDestroy() override;
+
+    // When create_view_models_lazily is set, the mission and objective view models are only created at the end of the frame GetActiveMissions is first called
+    void Initialize( bool create_view_models_lazily );
+
     void SetMissionStarted( UMSMission * mission );
     void SetMissionEnded( UMSMission * mission );
     void SetMissionObjectiveStarted( UMSMission * mission, const TSubclassOf< UMSMissionObjective > & objective );
     void SetMissionObjectiveEnded( UMSMission * mission, const TSubclassOf<UMSMissionObjective> & objective );
 
+    // Broadcasts the field notifications of the view models which changed since the last flush
+    void FlushChanges();
+
+    UMSObjectiveViewModel * AcquireObjectiveViewModel();
+    void ReleaseObjectiveViewModel( UMSObjectiveViewModel * objective_vm );
+
+    // Number of mission and objective view models created by this view model, including the pooled ones
+    int32 GetMissionViewModelCount() const;
+    int32 GetPooledMissionViewModelCount() const;
+    int32 GetObjectiveViewModelCount() const;
+    int32 GetPooledObjectiveViewModelCount() const;
+
+    UFUNCTION( BlueprintPure, FieldNotify, Category = "ViewModel" )
+    TArray< UMSMissionViewModel * > GetActiveMissions() const;
+
 private:
     UMSMissionViewModel * GetMissionViewModel( UMSMission * mission ) const;
+    UMSMissionViewModel * AddMissionViewModel( UMSMission * mission );
+    void CreateViewModels();
+    void MarkDirty( UMSMissionViewModel * mission_vm );
 
-    UPROPERTY( BlueprintReadOnly, FieldNotify, meta = ( AllowPrivateAccess ) )
+    // Only exposed through GetActiveMissions, which requests the view models when they are created lazily
+    UPROPERTY( Transient )
     TArray< TObjectPtr< UMSMissionViewModel > > ActiveMissions;
+
+    UPROPERTY( BlueprintAssignable, meta = ( AllowPrivateAccess ) )
+    FMSOnMissionViewModelAddedDelegate OnMissionAdded;
+
+    UPROPERTY( BlueprintAssignable, meta = ( AllowPrivateAccess ) )
+    FMSOnMissionViewModelRemovedDelegate OnMissionRemoved;
+
+    // The active missions, in the order they started. Tracked even when the view models are not created yet
+    UPROPERTY( Transient )
+    TArray< TObjectPtr< UMSMission > > Missions;
+
+    UPROPERTY( Transient )
+    TMap< TObjectPtr< UMSMission >, TObjectPtr< UMSMissionViewModel > > MissionViewModels;
+
+    // Mission view models whose objectives changed since the last flush
+    UPROPERTY( Transient )
+    TArray< TObjectPtr< UMSMissionViewModel > > DirtyMissionViewModels;
+
+    UPROPERTY( Transient )
+    TArray< TObjectPtr< UMSMissionViewModel > > MissionViewModelPool;
+
+    UPROPERTY( Transient )
+    TArray< TObjectPtr< UMSObjectiveViewModel > > ObjectiveViewModelPool;
+
+    FDelegateHandle EndFrameDelegateHandle;
+    int32 MissionViewModelCount;
+    int32 ObjectiveViewModelCount;
+    bool bAreActiveMissionsDirty;
+    bool bAreViewModelsCreated;
+
+    // Set by GetActiveMissions, which is const like all the field notify functions, so the view models are created by the next flush
+    mutable bool bAreViewModelsRequested;
 };
+
+FORCEINLINE int32 UMSViewModel::GetMissionViewModelCount() const
+{
+    return MissionViewModelCount;
+}
+
+FORCEINLINE int32 UMSViewModel::GetPooledMissionViewModelCount() const
+{
+    return MissionViewModelPool.Num();
+}
+
+FORCEINLINE int32 UMSViewModel::GetObjectiveViewModelCount() const
+{
+    return ObjectiveViewModelCount;
+}
+
+FORCEINLINE int32 UMSViewModel::GetPooledObjectiveViewModelCount() const
+{
+    return ObjectiveViewModelPool.Num();
+}
@@ -13,6 +13,9 @@ public class MissionSystemEditor : ModuleRules
             "Core",
             "CoreUObject",
             "Engine",
+            "Slate",
+            "SlateCore",
+            "ToolMenus",
             "UnrealEd"
             });
 
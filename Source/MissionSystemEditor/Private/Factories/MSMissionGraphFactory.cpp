@@ -0,0 +1,26 @@
+#include "Factories/MSMissionGraphFactory.h"
+
+#include "MSMissionGraph.h"
+
+UMSMissionGraphFactory::UMSMissionGraphFactory( const FObjectInitializer & object_initializer ) :
+    Super( object_initializer )
+{
+    bCreateNew = true;
+
+    // true if the associated editor should be opened after creating a new object.
+    bEditAfterNew = true;
+    SupportedClass = UMSMissionGraph::StaticClass();
+}
+
+UObject * UMSMissionGraphFactory::FactoryCreateNew(
+    UClass * Class,
+    UObject * InParent,
+    FName Name,
+    EObjectFlags Flags,
+    UObject * Context,
+    FFeedbackContext * Warn )
+{
+    auto * mission_graph = NewObject< UMSMissionGraph >( InParent, Class, Name, Flags | RF_Transactional );
+    mission_graph->Compile();
+    return mission_graph;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "MSMissionGraphAssetTypeActions.h"
+
+#include "MSMissionGraph.h"
+
+#include <ToolMenuSection.h>
+
+FMSMissionGraphAssetTypeActions::FMSMissionGraphAssetTypeActions( EAssetTypeCategories::Type category ) :
+    Category( category )
+{
+}
+
+FText FMSMissionGraphAssetTypeActions::GetName() const
+{
+    return INVTEXT( "Mission Graph" );
+}
+
+FColor FMSMissionGraphAssetTypeActions::GetTypeColor() const
+{
+    return FColor::Turquoise;
+}
+
+UClass * FMSMissionGraphAssetTypeActions::GetSupportedClass() const
+{
+    return UMSMissionGraph::StaticClass();
+}
+
+uint32 FMSMissionGraphAssetTypeActions::GetCategories()
+{
+    return Category;
+}
+
+bool FMSMissionGraphAssetTypeActions::HasActions( const TArray< UObject * > & /*objects*/ ) const
+{
+    return true;
+}
+
+void FMSMissionGraphAssetTypeActions::GetActions( const TArray< UObject * > & objects, FToolMenuSection & section )
+{
+    const auto mission_graphs = GetTypedWeakObjectPtrs< UMSMissionGraph >( objects );
+
+    section.AddMenuEntry(
+        "MissionGraph_Compile",
+        INVTEXT( "Compile" ),
+        INVTEXT( "Compiles all the mission data in the mission graph." ),
+        FSlateIcon(),
+        FUIAction( FExecuteAction::CreateStatic( &FMSMissionGraphAssetTypeActions::CompileMissionGraphs, mission_graphs ) ) );
+}
+
+void FMSMissionGraphAssetTypeActions::CompileMissionGraphs( const TArray< TWeakObjectPtr< UMSMissionGraph > > mission_graphs )
+{
+    for ( const auto & mission_graph : mission_graphs )
+    {
+        if ( mission_graph.IsValid() )
+        {
+            mission_graph->Compile();
+            mission_graph->MarkPackageDirty();
+        }
+    }
+}
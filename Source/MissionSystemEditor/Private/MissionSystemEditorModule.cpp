@@ -1,6 +1,7 @@
 #include "MissionSystemEditorModule.h"
 
 #include "MSMissionDataAssetTypeActions.h"
+#include "MSMissionGraphAssetTypeActions.h"
 
 #include <Modules/ModuleManager.h>
 
@@ -20,6 +21,7 @@ void FMissionSystemEditor::StartupModule()
     const auto bit = asset_tools.RegisterAdvancedAssetCategory( MISSION_SYSTEM_MENU_CATEGORY_KEY, MISSION_SYSTEM_MENU_CATEGORY_KEY_TEXT );
 
     RegisterAction< FMSMissionDataAssetTypeActions >( bit );
+    RegisterAction< FMSMissionGraphAssetTypeActions >( bit );
 }
 
 void FMissionSystemEditor::ShutdownModule()
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Factories/Factory.h>
+
+#include "MSMissionGraphFactory.generated.h"
+
+UCLASS()
+class MISSIONSYSTEMEDITOR_API UMSMissionGraphFactory final : public UFactory
+{
+    GENERATED_BODY()
+
+public:
+    explicit UMSMissionGraphFactory( const FObjectInitializer & object_initializer );
+
+    UObject * FactoryCreateNew(
+        UClass * Class,
+        UObject * InParent,
+        FName Name,
+        EObjectFlags Flags,
+        UObject * Context,
+        FFeedbackContext * Warn ) override;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "AssetTypeActions_Base.h"
+
+class UMSMissionGraph;
+
+class FMSMissionGraphAssetTypeActions final : public FAssetTypeActions_Base
+{
+public:
+    FMSMissionGraphAssetTypeActions( EAssetTypeCategories::Type category );
+
+    FText GetName() const override;
+    FColor GetTypeColor() const override;
+    UClass * GetSupportedClass() const override;
+    uint32 GetCategories() override;
+    bool HasActions( const TArray< UObject * > & objects ) const override;
+    void GetActions( const TArray< UObject * > & objects, FToolMenuSection & section ) override;
+
+private:
+    static void CompileMissionGraphs( TArray< TWeakObjectPtr< UMSMissionGraph > > mission_graphs );
+
+    EAssetTypeCategories::Type Category;
+};
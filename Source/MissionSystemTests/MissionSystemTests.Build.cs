@@ -0,0 +1,21 @@
+using UnrealBuildTool;
+
+public class MissionSystemTests : ModuleRules
+{
+    public MissionSystemTests(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PrivateDependencyModuleNames.AddRange(new string[] {
+            "Core",
+            "CoreUObject",
+            "Engine",
+            "Json",
+            "MissionSystem"
+            });
+
+        // The replication bandwidth test runs a listen server and a client in PIE
+        if (Target.bBuildEditor)
+        {
+            PrivateDependencyModuleNames.Add("UnrealEd");
+        }
+    }
+}
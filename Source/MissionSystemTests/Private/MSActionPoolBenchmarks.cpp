@@ -0,0 +1,107 @@
+#include "MSBenchmarkReport.h"
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestMissionGraph.h"
+
+#include <HAL/IConsoleManager.h>
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Missions x Objectives per mission x Actions per step
+    const FMSTestMissionGraphParameters ActionPoolBenchmarkScales[] = {
+        { 10, 100, 2 },
+        { 100, 100, 4 },
+    };
+
+    constexpr auto ActionPoolIterationCount = 10;
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST( FMSActionPoolBenchmark, "MissionSystem.Benchmarks.ActionPool", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter )
+
+void FMSActionPoolBenchmark::GetTests( TArray< FString > & out_beautified_names, TArray< FString > & out_test_commands ) const
+{
+    for ( const auto & parameters : ActionPoolBenchmarkScales )
+    {
+        out_beautified_names.Add( parameters.ToString() );
+        out_test_commands.Add( parameters.ToString() );
+    }
+}
+
+bool FMSActionPoolBenchmark::RunTest( const FString & parameters_string )
+{
+    FMSTestMissionGraphParameters parameters( 0, 0, 0 );
+    if ( !FMSTestMissionGraphParameters::Parse( parameters_string, parameters ) )
+    {
+        AddError( FString::Printf( TEXT( "Invalid benchmark parameters : %s" ), *parameters_string ) );
+        return false;
+    }
+
+    auto * pool_actions_variable = IConsoleManager::Get().FindConsoleVariable( TEXT( "MissionSystem.PoolActions" ) );
+    if ( !TestNotNull( TEXT( "MissionSystem.PoolActions exists" ), pool_actions_variable ) )
+    {
+        return false;
+    }
+
+    const auto pool_actions = pool_actions_variable->GetBool();
+
+    const FMSTestMissionGraph graph( parameters );
+    const auto & missions = graph.GetMissions();
+    const auto metric_prefix = parameters.ToString();
+
+    FMSBenchmarkReport report( *this );
+
+    // Runs all the missions to completion on the same component, so the actions released by an iteration can be reused by the next one
+    const auto measure_mission_cycle = [ & ]( const bool use_pool ) {
+        pool_actions_variable->Set( use_pool );
+
+        auto * component = graph.CreateComponent();
+
+        report.Measure(
+            metric_prefix + ( use_pool ? TEXT( ".MissionCycle.Pooled" ) : TEXT( ".MissionCycle.Unpooled" ) ),
+            ActionPoolIterationCount,
+            [ & ]() {
+                component->ClearMissionHistory();
+            },
+            [ & ]() {
+                for ( auto * mission_data : missions )
+                {
+                    component->StartMission( mission_data );
+                }
+
+                graph.CompleteObjectives( component, parameters.ObjectivesPerMission );
+
+                // The component has no world to tick in the tests, so the released actions are returned to the pool here
+                component->FlushReleasedObjects();
+            } );
+
+        for ( auto * mission_data : missions )
+        {
+            TestTrue( TEXT( "The mission is complete after all its objectives have been completed" ), component->IsMissionComplete( mission_data ) );
+        }
+
+        const auto & action_pool = component->GetActionPool();
+
+        if ( use_pool )
+        {
+            TestTrue( TEXT( "Actions are reused from the pool" ), action_pool.GetHitCount() > 0 );
+        }
+        else
+        {
+            TestEqual( TEXT( "No action is reused without the pool" ), action_pool.GetHitCount(), 0u );
+        }
+
+        FMSTestMissionGraph::DestroyComponent( component );
+    };
+
+    measure_mission_cycle( false );
+    measure_mission_cycle( true );
+
+    pool_actions_variable->Set( pool_actions );
+
+    return report.CompareAndSave();
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "MSBenchmarkReport.h"
+
+#include <Dom/JsonObject.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/AutomationTest.h>
+#include <Misc/CommandLine.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+
+static TAutoConsoleVariable< FString > CVarBenchmarkBaselinePath(
+    TEXT( "MissionSystem.Benchmark.BaselinePath" ),
+    TEXT( "" ),
+    TEXT( "Path of the JSON file used as the baseline of the mission system benchmarks. Defaults to Saved/MissionSystem/BenchmarkBaseline.json" ),
+    ECVF_Default );
+
+static TAutoConsoleVariable< float > CVarBenchmarkRegressionThreshold(
+    TEXT( "MissionSystem.Benchmark.RegressionThreshold" ),
+    0.25f,
+    TEXT( "Relative slowdown compared to the baseline above which a mission system benchmark fails. 0.25 means 25% slower." ),
+    ECVF_Default );
+
+static TAutoConsoleVariable< float > CVarBenchmarkNoiseFloor(
+    TEXT( "MissionSystem.Benchmark.NoiseFloorMs" ),
+    0.05f,
+    TEXT( "Absolute difference in milliseconds under which a slowdown is considered as noise and never fails a benchmark." ),
+    ECVF_Default );
+
+namespace
+{
+    const TCHAR * const MetricsFieldName = TEXT( "Metrics" );
+}
+
+FMSBenchmarkReport::FMSBenchmarkReport( FAutomationTestBase & test ) :
+    Test( test )
+{
+}
+
+void FMSBenchmarkReport::Record( const FString & metric_name, const double milliseconds )
+{
+    Metrics.Add( metric_name, milliseconds );
+    Test.AddInfo( FString::Printf( TEXT( "%s : %.4f ms" ), *metric_name, milliseconds ) );
+}
+
+bool FMSBenchmarkReport::CompareAndSave()
+{
+    const auto baseline_path = GetBaselinePath();
+    const auto update_baseline = FParse::Param( FCommandLine::Get(), TEXT( "MSUpdateBenchmarkBaseline" ) );
+    const auto threshold = CVarBenchmarkRegressionThreshold.GetValueOnAnyThread();
+    const auto noise_floor = CVarBenchmarkNoiseFloor.GetValueOnAnyThread();
+
+    TMap< FString, double > baseline;
+    LoadMetrics( baseline_path, baseline );
+
+    auto result = true;
+    auto baseline_changed = false;
+
+    for ( const auto & [ metric_name, milliseconds ] : Metrics )
+    {
+        const auto * baseline_milliseconds = baseline.Find( metric_name );
+
+        if ( update_baseline || baseline_milliseconds == nullptr )
+        {
+            baseline.Add( metric_name, milliseconds );
+            baseline_changed = true;
+            continue;
+        }
+
+        const auto difference = milliseconds - *baseline_milliseconds;
+
+        if ( difference > noise_floor && milliseconds > *baseline_milliseconds * ( 1.0 + threshold ) )
+        {
+            Test.AddError( FString::Printf( TEXT( "%s regressed : %.4f ms, baseline is %.4f ms (+%.1f%%)" ),
+                *metric_name,
+                milliseconds,
+                *baseline_milliseconds,
+                *baseline_milliseconds > 0.0 ? difference / *baseline_milliseconds * 100.0 : 100.0 ) );
+            result = false;
+        }
+    }
+
+    if ( baseline_changed )
+    {
+        SaveMetrics( baseline_path, baseline );
+    }
+
+    TMap< FString, double > results;
+    LoadMetrics( GetResultsPath(), results );
+    results.Append( Metrics );
+    SaveMetrics( GetResultsPath(), results );
+
+    return result;
+}
+
+FString FMSBenchmarkReport::GetBaselinePath()
+{
+    const auto path = CVarBenchmarkBaselinePath.GetValueOnAnyThread();
+
+    if ( !path.IsEmpty() )
+    {
+        return path;
+    }
+
+    return FPaths::Combine( FPaths::ProjectSavedDir(), TEXT( "MissionSystem" ), TEXT( "BenchmarkBaseline.json" ) );
+}
+
+FString FMSBenchmarkReport::GetResultsPath()
+{
+    return FPaths::Combine( FPaths::GetPath( GetBaselinePath() ), TEXT( "BenchmarkResults.json" ) );
+}
+
+bool FMSBenchmarkReport::LoadMetrics( const FString & path, TMap< FString, double > & metrics )
+{
+    FString json_string;
+    if ( !FFileHelper::LoadFileToString( json_string, *path ) )
+    {
+        return false;
+    }
+
+    TSharedPtr< FJsonObject > json_object;
+    if ( !FJsonSerializer::Deserialize( TJsonReaderFactory<>::Create( json_string ), json_object ) || !json_object.IsValid() )
+    {
+        return false;
+    }
+
+    const TSharedPtr< FJsonObject > * metrics_object = nullptr;
+    if ( !json_object->TryGetObjectField( MetricsFieldName, metrics_object ) )
+    {
+        return false;
+    }
+
+    for ( const auto & [ metric_name, value ] : ( *metrics_object )->Values )
+    {
+        double milliseconds;
+        if ( value->TryGetNumber( milliseconds ) )
+        {
+            metrics.Add( metric_name, milliseconds );
+        }
+    }
+
+    return true;
+}
+
+bool FMSBenchmarkReport::SaveMetrics( const FString & path, const TMap< FString, double > & metrics )
+{
+    const auto metrics_object = MakeShared< FJsonObject >();
+
+    for ( const auto & [ metric_name, milliseconds ] : metrics )
+    {
+        metrics_object->SetNumberField( metric_name, milliseconds );
+    }
+
+    const auto json_object = MakeShared< FJsonObject >();
+    json_object->SetObjectField( MetricsFieldName, metrics_object );
+
+    FString json_string;
+    if ( !FJsonSerializer::Serialize( json_object, TJsonWriterFactory<>::Create( &json_string ) ) )
+    {
+        return false;
+    }
+
+    return FFileHelper::SaveStringToFile( json_string, *path );
+}
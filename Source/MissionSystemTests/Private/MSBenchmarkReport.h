@@ -0,0 +1,55 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+class FAutomationTestBase;
+
+/* Collects the timings measured by a benchmark test, compares them to the JSON baseline and writes the results next to it
+ The baseline is created from the first run if it does not exist yet, or when the command line contains -MSUpdateBenchmarkBaseline
+ */
+class FMSBenchmarkReport
+{
+public:
+    explicit FMSBenchmarkReport( FAutomationTestBase & test );
+
+    // Runs setup then body iteration_count times, and records the median duration of body in milliseconds
+    template < typename _SetupType_, typename _BodyType_ >
+    double Measure( const FString & metric_name, int32 iteration_count, _SetupType_ && setup, _BodyType_ && body );
+
+    void Record( const FString & metric_name, double milliseconds );
+
+    // Returns false when at least one metric regressed beyond the threshold
+    bool CompareAndSave();
+
+private:
+    static FString GetBaselinePath();
+    static FString GetResultsPath();
+    static bool LoadMetrics( const FString & path, TMap< FString, double > & metrics );
+    static bool SaveMetrics( const FString & path, const TMap< FString, double > & metrics );
+
+    FAutomationTestBase & Test;
+    TMap< FString, double > Metrics;
+};
+
+template < typename _SetupType_, typename _BodyType_ >
+double FMSBenchmarkReport::Measure( const FString & metric_name, const int32 iteration_count, _SetupType_ && setup, _BodyType_ && body )
+{
+    TArray< double > durations;
+    durations.Reserve( iteration_count );
+
+    for ( auto iteration = 0; iteration < iteration_count; ++iteration )
+    {
+        setup();
+
+        const auto start_time = FPlatformTime::Seconds();
+        body();
+        durations.Add( ( FPlatformTime::Seconds() - start_time ) * 1000.0 );
+    }
+
+    durations.Sort();
+
+    const auto median = durations.Num() > 0 ? durations[ durations.Num() / 2 ] : 0.0;
+    Record( metric_name, median );
+
+    return median;
+}
@@ -0,0 +1,191 @@
+#include "MSBenchmarkReport.h"
+#include "MSMissionHistory.h"
+
+#include <HAL/IConsoleManager.h>
+#include <Math/RandomStream.h>
+#include <Misc/AutomationTest.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+#include <UObject/ObjectResource.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Number of objectives in the history. There is one mission for every 10 objectives
+    const int32 HistoryBenchmarkEntryCounts[] = {
+        1000,
+        10000,
+    };
+
+    constexpr auto HistoryIterationCount = 20;
+
+    void FillHistory( FMSMissionHistory & history, const int32 entry_count, TArray< FGuid > & out_mission_ids, TArray< FGuid > & out_objective_ids )
+    {
+        FRandomStream random_stream( entry_count );
+
+        const auto make_id = [ & ]() {
+            return FGuid( random_stream.GetUnsignedInt(), random_stream.GetUnsignedInt(), random_stream.GetUnsignedInt(), random_stream.GetUnsignedInt() );
+        };
+
+        // Most missions are finished, and the last ones are still active
+        for ( auto index = 0; index < entry_count / 10; ++index )
+        {
+            const auto mission_id = out_mission_ids.Add_GetRef( make_id() );
+            history.SetMissionState( mission_id, random_stream.FRand() < 0.1f ? EMSState::Active : EMSState::Complete );
+        }
+
+        for ( auto index = 0; index < entry_count; ++index )
+        {
+            const auto objective_id = out_objective_ids.Add_GetRef( make_id() );
+            history.SetObjectiveState( objective_id, static_cast< EMSState >( random_stream.RandRange( 0, 2 ) ) );
+        }
+    }
+
+    // Size of the history saved with the Initial layout, the on-disk format before the history was versioned: the active missions as references
+    // to their mission data, which take the size of a package index, then a map from GUID to state for the missions and for the objectives
+    int64 GetInitialVersionSize( const FMSMissionHistory & history )
+    {
+        const auto get_states = []( const FMSMissionStateTable & table ) {
+            TMap< FGuid, EMSState > states;
+            states.Reserve( table.GetStateCount() );
+
+            for ( auto index = 0; index < table.Num(); ++index )
+            {
+                if ( const auto state = table.GetState( index ); state.IsSet() && table.HasId( index ) )
+                {
+                    states.Add( table.GetId( index ), state.GetValue() );
+                }
+            }
+
+            return states;
+        };
+
+        auto mission_states = get_states( history.GetMissionStates() );
+        auto objective_states = get_states( history.GetObjectiveStates() );
+
+        TArray< uint8 > bytes;
+        FMemoryWriter writer( bytes );
+
+        auto active_missions_count = history.GetActiveMissionIds().Num();
+        writer << active_missions_count;
+
+        for ( auto index = 0; index < active_missions_count; ++index )
+        {
+            FPackageIndex mission_data_index;
+            writer << mission_data_index;
+        }
+
+        writer << mission_states;
+        writer << objective_states;
+
+        return bytes.Num();
+    }
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST( FMSMissionHistoryBenchmark, "MissionSystem.Benchmarks.MissionHistory", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter )
+
+void FMSMissionHistoryBenchmark::GetTests( TArray< FString > & out_beautified_names, TArray< FString > & out_test_commands ) const
+{
+    for ( const auto entry_count : HistoryBenchmarkEntryCounts )
+    {
+        out_beautified_names.Add( FString::FromInt( entry_count ) );
+        out_test_commands.Add( FString::FromInt( entry_count ) );
+    }
+}
+
+bool FMSMissionHistoryBenchmark::RunTest( const FString & parameters_string )
+{
+    const auto entry_count = FCString::Atoi( *parameters_string );
+    if ( entry_count <= 0 )
+    {
+        AddError( FString::Printf( TEXT( "Invalid benchmark parameters : %s" ), *parameters_string ) );
+        return false;
+    }
+
+    auto * compress_history_variable = IConsoleManager::Get().FindConsoleVariable( TEXT( "MissionSystem.CompressHistory" ) );
+    if ( !TestNotNull( TEXT( "MissionSystem.CompressHistory exists" ), compress_history_variable ) )
+    {
+        return false;
+    }
+
+    const auto compress_history = compress_history_variable->GetBool();
+
+    FMSMissionHistory history;
+    TArray< FGuid > mission_ids;
+    TArray< FGuid > objective_ids;
+    FillHistory( history, entry_count, mission_ids, objective_ids );
+
+    const auto initial_version_size = GetInitialVersionSize( history );
+    AddInfo( FString::Printf( TEXT( "%s.Size.InitialVersion : %lld bytes" ), *parameters_string, initial_version_size ) );
+
+    FMSBenchmarkReport report( *this );
+
+    const auto measure_history = [ & ]( const bool use_compression ) {
+        compress_history_variable->Set( use_compression );
+
+        const auto metric_prefix = parameters_string + ( use_compression ? TEXT( ".Compressed" ) : TEXT( ".Uncompressed" ) );
+        TArray< uint8 > bytes;
+
+        report.Measure(
+            metric_prefix + TEXT( ".Save" ),
+            HistoryIterationCount,
+            [ & ]() {
+                bytes.Reset();
+            },
+            [ & ]() {
+                FMemoryWriter writer( bytes );
+                writer << history;
+            } );
+
+        AddInfo( FString::Printf( TEXT( "%s.Size : %d bytes" ), *metric_prefix, bytes.Num() ) );
+
+        // :NOTE: GUIDs are random and barely compress, so only the uncompressed size is compared
+        if ( !use_compression )
+        {
+            TestTrue( TEXT( "The compact history is smaller than the history saved with the initial version" ), bytes.Num() < initial_version_size );
+        }
+
+        FMSMissionHistory loaded_history;
+        auto load_succeeded = true;
+
+        report.Measure(
+            metric_prefix + TEXT( ".Load" ),
+            HistoryIterationCount,
+            [ & ]() {
+                loaded_history.Clear();
+            },
+            [ & ]() {
+                FMemoryReader reader( bytes );
+                reader << loaded_history;
+                load_succeeded &= !reader.IsError();
+            } );
+
+        TestTrue( TEXT( "The history is loaded without error" ), load_succeeded );
+        TestEqual( TEXT( "The active missions are loaded" ), loaded_history.GetActiveMissionIds(), history.GetActiveMissionIds() );
+
+        auto mismatch_count = 0;
+
+        for ( const auto & mission_id : mission_ids )
+        {
+            mismatch_count += loaded_history.IsMissionComplete( mission_id ) != history.IsMissionComplete( mission_id ) ? 1 : 0;
+        }
+
+        for ( const auto & objective_id : objective_ids )
+        {
+            mismatch_count += loaded_history.IsObjectiveActive( objective_id ) != history.IsObjectiveActive( objective_id ) ? 1 : 0;
+            mismatch_count += loaded_history.IsObjectiveCancelled( objective_id ) != history.IsObjectiveCancelled( objective_id ) ? 1 : 0;
+        }
+
+        TestEqual( TEXT( "The loaded states match the saved states" ), mismatch_count, 0 );
+    };
+
+    measure_history( false );
+    measure_history( true );
+
+    compress_history_variable->Set( compress_history );
+
+    return report.CompareAndSave();
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "MSBenchmarkReport.h"
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestMissionGraph.h"
+
+#include <Misc/AutomationTest.h>
+#include <Serialization/ObjectReader.h>
+#include <Serialization/ObjectWriter.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Missions x Objectives per mission x Actions per step. The largest scales reach 10k objectives
+    const FMSTestMissionGraphParameters BenchmarkScales[] = {
+        { 1, 10, 1 },
+        { 10, 100, 2 },
+        { 100, 100, 2 },
+        { 10, 1000, 2 },
+    };
+
+    int32 GetIterationCount( const FMSTestMissionGraphParameters & parameters )
+    {
+        return FMath::Clamp( 20000 / parameters.GetObjectiveCount(), 3, 20 );
+    }
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST( FMSMissionLifecycleBenchmark, "MissionSystem.Benchmarks.MissionLifecycle", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter )
+
+void FMSMissionLifecycleBenchmark::GetTests( TArray< FString > & out_beautified_names, TArray< FString > & out_test_commands ) const
+{
+    for ( const auto & parameters : BenchmarkScales )
+    {
+        out_beautified_names.Add( parameters.ToString() );
+        out_test_commands.Add( parameters.ToString() );
+    }
+}
+
+bool FMSMissionLifecycleBenchmark::RunTest( const FString & parameters_string )
+{
+    FMSTestMissionGraphParameters parameters( 0, 0, 0 );
+    if ( !FMSTestMissionGraphParameters::Parse( parameters_string, parameters ) )
+    {
+        AddError( FString::Printf( TEXT( "Invalid benchmark parameters : %s" ), *parameters_string ) );
+        return false;
+    }
+
+    const FMSTestMissionGraph graph( parameters );
+    const auto & missions = graph.GetMissions();
+    const auto iteration_count = GetIterationCount( parameters );
+    const auto metric_prefix = parameters.ToString();
+
+    FMSBenchmarkReport report( *this );
+    UMSMissionSystemComponent * component = nullptr;
+
+    const auto reset_component = [ & ]() {
+        FMSTestMissionGraph::DestroyComponent( component );
+        component = graph.CreateComponent();
+    };
+
+    const auto start_missions = [ & ]() {
+        for ( auto * mission_data : missions )
+        {
+            component->StartMission( mission_data );
+        }
+    };
+
+    report.Measure( metric_prefix + TEXT( ".StartMission" ), iteration_count, reset_component, start_missions );
+
+    for ( auto * mission_data : missions )
+    {
+        TestTrue( TEXT( "The mission is active after StartMission" ), component->IsMissionActive( mission_data ) );
+    }
+
+    report.Measure(
+        metric_prefix + TEXT( ".CompleteObjective" ),
+        iteration_count,
+        [ & ]() {
+            reset_component();
+            start_missions();
+        },
+        [ & ]() {
+            graph.CompleteObjectives( component, parameters.ObjectivesPerMission );
+        } );
+
+    for ( auto * mission_data : missions )
+    {
+        TestTrue( TEXT( "The mission is complete after all its objectives have been completed" ), component->IsMissionComplete( mission_data ) );
+    }
+
+    // Build a history where every mission is active and has half of its objectives finished
+    const auto completed_objectives = parameters.ObjectivesPerMission / 2;
+
+    reset_component();
+    start_missions();
+    graph.CompleteObjectives( component, completed_objectives );
+
+    TArray< uint8 > component_bytes;
+    FObjectWriter( component, component_bytes );
+
+    auto * history_component = component;
+    component = nullptr;
+
+    report.Measure(
+        metric_prefix + TEXT( ".ResumeMissionsFromHistory" ),
+        iteration_count,
+        [ & ]() {
+            reset_component();
+            FObjectReader( component, component_bytes );
+        },
+        [ & ]() {
+            component->ResumeMissionsFromHistory();
+        } );
+
+    for ( auto * mission_data : missions )
+    {
+        TestNotNull( TEXT( "The mission is resumed from the history" ), component->GetActiveMission( mission_data ) );
+    }
+
+    const auto & history = history_component->GetMissionHistory();
+    auto match_count = 0;
+
+    report.Measure(
+        metric_prefix + TEXT( ".HistoryQueries" ),
+        iteration_count,
+        []() {
+        },
+        [ & ]() {
+            match_count = 0;
+
+            for ( auto mission_index = 0; mission_index < missions.Num(); ++mission_index )
+            {
+                match_count += history.IsMissionActive( missions[ mission_index ] ) ? 1 : 0;
+                match_count += history.IsMissionFinished( missions[ mission_index ] ) ? 1 : 0;
+
+                for ( const auto & objective : graph.GetObjectives( mission_index ) )
+                {
+                    match_count += history.IsObjectiveActive( objective ) ? 1 : 0;
+                    match_count += history.IsObjectiveFinished( objective ) ? 1 : 0;
+                }
+            }
+        } );
+
+    // Every mission is active, with half of its objectives finished and the next one active
+    TestEqual( TEXT( "History queries match the history" ), match_count, parameters.MissionCount * ( completed_objectives + 2 ) );
+
+    FMSTestMissionGraph::DestroyComponent( component );
+    FMSTestMissionGraph::DestroyComponent( history_component );
+
+    return report.CompareAndSave();
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestMissionGraph.h"
+#include "MSTestTypes.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FMSObjectivePipeliningTest, "MissionSystem.Objectives.Pipelining", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter )
+
+bool FMSObjectivePipeliningTest::RunTest( const FString & /*parameters*/ )
+{
+    const FMSTestMissionGraph graph( FMSTestMissionGraphParameters( 1, 2, 0 ) );
+    auto * mission_data = graph.GetMissions()[ 0 ];
+    const auto objectives = graph.GetObjectives( 0 );
+
+    mission_data->bPipelineObjectiveActions = true;
+
+    // The end action of the first objective is a fade out, and the barrier start action of the second one a fade in which must not overlap with it
+    auto * first_cdo = objectives[ 0 ]->GetDefaultObject< UMSTestObjective >();
+    auto * second_cdo = objectives[ 1 ]->GetDefaultObject< UMSTestObjective >();
+
+    auto * end_action = NewObject< UMSTestLatentAction >( first_cdo, NAME_None, RF_Transient );
+    auto * barrier_action = NewObject< UMSTestLatentAction >( second_cdo, NAME_None, RF_Transient );
+    auto * start_action = NewObject< UMSTestLatentAction >( second_cdo, NAME_None, RF_Transient );
+    barrier_action->SetPipelineBarrier( true );
+
+    first_cdo->SetActions( {}, { end_action } );
+    second_cdo->SetActions( { barrier_action, start_action }, {} );
+
+    auto * component = graph.CreateComponent();
+    const auto & history = component->GetMissionHistory();
+
+    component->StartMission( mission_data );
+    component->CompleteObjective( mission_data, objectives[ 0 ] );
+
+    TestTrue( TEXT( "The next objective starts while the end actions of the previous one are running" ), history.IsObjectiveActive( objectives[ 1 ] ) );
+    TestEqual( TEXT( "The barrier action waits for the end actions of the previous objective" ), UMSTestLatentAction::GetExecutingActionCount(), 2 );
+
+    UMSTestLatentAction::FinishExecutingActions();
+    TestEqual( TEXT( "The barrier action is executed once the end actions of the previous objective have finished" ), UMSTestLatentAction::GetExecutingActionCount(), 1 );
+
+    UMSTestLatentAction::FinishExecutingActions();
+    component->CompleteObjective( mission_data, objectives[ 1 ] );
+    TestTrue( TEXT( "The mission is complete once all its objectives have been completed" ), component->IsMissionComplete( mission_data ) );
+
+    // The objective classes are shared by all the test graphs
+    first_cdo->SetActions( {}, {} );
+    second_cdo->SetActions( {}, {} );
+
+    FMSTestMissionGraph::DestroyComponent( component );
+
+    return true;
+}
+
+#endif
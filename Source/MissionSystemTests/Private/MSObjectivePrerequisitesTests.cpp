@@ -0,0 +1,100 @@
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestMissionGraph.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FMSObjectivePrerequisitesTest, "MissionSystem.Objectives.Prerequisites", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter )
+
+bool FMSObjectivePrerequisitesTest::RunTest( const FString & /*parameters*/ )
+{
+    const FMSTestMissionGraph graph( FMSTestMissionGraphParameters( 1, 4, 0 ) );
+    auto * mission_data = graph.GetMissions()[ 0 ];
+    const auto objectives = graph.GetObjectives( 0 );
+
+    // 0 -> ( 1, 2 ) -> 3
+    mission_data->Objectives[ 1 ].Prerequisites = { objectives[ 0 ].Get() };
+    mission_data->Objectives[ 2 ].Prerequisites = { objectives[ 0 ].Get() };
+    mission_data->Objectives[ 3 ].Prerequisites = { objectives[ 1 ].Get(), objectives[ 2 ].Get() };
+    mission_data->CompileObjectiveDependencies();
+
+    auto * component = graph.CreateComponent();
+    const auto & history = component->GetMissionHistory();
+
+    const auto test_active_objectives = [ & ]( const TCHAR * step, const TArray< bool > & expected_active_objectives ) {
+        for ( auto index = 0; index < objectives.Num(); ++index )
+        {
+            TestEqual( FString::Printf( TEXT( "%s : objective %d is active" ), step, index ), history.IsObjectiveActive( objectives[ index ] ), expected_active_objectives[ index ] );
+        }
+    };
+
+    component->StartMission( mission_data );
+    test_active_objectives( TEXT( "Mission started" ), { true, false, false, false } );
+
+    component->CompleteObjective( mission_data, objectives[ 0 ] );
+    test_active_objectives( TEXT( "Objective 0 completed" ), { false, true, true, false } );
+
+    component->CompleteObjective( mission_data, objectives[ 2 ] );
+    test_active_objectives( TEXT( "Objective 2 completed" ), { false, true, false, false } );
+
+    component->CompleteObjective( mission_data, objectives[ 1 ] );
+    test_active_objectives( TEXT( "Objective 1 completed" ), { false, false, false, true } );
+
+    component->CompleteObjective( mission_data, objectives[ 3 ] );
+    TestTrue( TEXT( "The mission is complete once all its objectives have been completed" ), component->IsMissionComplete( mission_data ) );
+
+    // A cycle is ignored, and the objectives run in the order of the list
+    mission_data->Objectives[ 0 ].Prerequisites = { objectives[ 3 ].Get() };
+
+    FMSObjectiveDependencies dependencies;
+    TestFalse( TEXT( "A cycle in the prerequisites is detected" ), dependencies.Build( mission_data->Objectives ) );
+    TestTrue( TEXT( "The objectives run in the order of the list when the prerequisites contain a cycle" ), TArray< int32 >( dependencies.GetTopologicalOrder() ) == TArray< int32 >( { 0, 1, 2, 3 } ) );
+
+    for ( auto & objective_data : mission_data->Objectives )
+    {
+        objective_data.Prerequisites.Reset();
+    }
+
+    // A prerequisite placed after the objective which needs it does not wait for the previous objectives of the list : 0, 3 -> 1 -> 2
+    mission_data->Objectives[ 1 ].Prerequisites = { objectives[ 3 ].Get() };
+
+    TestTrue( TEXT( "A prerequisite placed later in the list is not a cycle" ), dependencies.Build( mission_data->Objectives ) );
+    mission_data->CompileObjectiveDependencies();
+
+    FMSTestMissionGraph::DestroyComponent( component );
+
+    // The objectives are completed in the history of the previous component, so the mission runs again on a new one
+    component = graph.CreateComponent();
+    const auto & forward_history = component->GetMissionHistory();
+
+    const auto test_forward_active_objectives = [ & ]( const TCHAR * step, const TArray< bool > & expected_active_objectives ) {
+        for ( auto index = 0; index < objectives.Num(); ++index )
+        {
+            TestEqual( FString::Printf( TEXT( "%s : objective %d is active" ), step, index ), forward_history.IsObjectiveActive( objectives[ index ] ), expected_active_objectives[ index ] );
+        }
+    };
+
+    component->StartMission( mission_data );
+    test_forward_active_objectives( TEXT( "Mission started with a forward prerequisite" ), { true, false, false, true } );
+
+    component->CompleteObjective( mission_data, objectives[ 3 ] );
+    test_forward_active_objectives( TEXT( "Forward prerequisite completed" ), { true, true, false, false } );
+
+    component->CompleteObjective( mission_data, objectives[ 0 ] );
+    component->CompleteObjective( mission_data, objectives[ 1 ] );
+    test_forward_active_objectives( TEXT( "Objectives 0 and 1 completed" ), { false, false, true, false } );
+
+    component->CompleteObjective( mission_data, objectives[ 2 ] );
+    TestTrue( TEXT( "The mission with a forward prerequisite is complete once all its objectives have been completed" ), component->IsMissionComplete( mission_data ) );
+
+    mission_data->Objectives[ 1 ].Prerequisites.Reset();
+    mission_data->CompileObjectiveDependencies();
+
+    FMSTestMissionGraph::DestroyComponent( component );
+
+    return true;
+}
+
+#endif
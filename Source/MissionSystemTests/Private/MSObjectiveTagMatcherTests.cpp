@@ -0,0 +1,31 @@
+#include "MSObjectiveTagMatcher.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FMSObjectiveTagMatcherTest, "MissionSystem.Objectives.TagMatcher", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter )
+
+bool FMSObjectiveTagMatcherTest::RunTest( const FString & /*parameters*/ )
+{
+    FMSObjectiveTagMatcher matcher;
+    TestFalse( TEXT( "An empty matcher matches nothing" ), matcher.MatchesTagName( TEXT( "Mission.Spawn.Wave" ) ) );
+
+    matcher.Build( { TEXT( "Spawn" ), TEXT( "boss" ), TEXT( "Spa" ) } );
+    TestTrue( TEXT( "A tag which contains a token matches" ), matcher.MatchesTagName( TEXT( "Mission.Spawn.Wave" ) ) );
+    TestTrue( TEXT( "The tokens are searched ignoring the case" ), matcher.MatchesTagName( TEXT( "Mission.BossFight" ) ) );
+    TestTrue( TEXT( "The result is cached by tag name" ), matcher.MatchesTagName( TEXT( "Mission.Spawn.Wave" ) ) );
+    TestFalse( TEXT( "A tag which contains no token does not match" ), matcher.MatchesTagName( TEXT( "Mission.Dialog" ) ) );
+    TestFalse( TEXT( "A tag which only contains the beginning of a token does not match" ), matcher.MatchesTagName( TEXT( "Mission.Sp" ) ) );
+
+    matcher.Build( { TEXT( "Dialog" ) } );
+    TestFalse( TEXT( "The cached results are discarded when the matcher is rebuilt" ), matcher.MatchesTagName( TEXT( "Mission.Spawn.Wave" ) ) );
+    TestTrue( TEXT( "The new tokens are used once the matcher is rebuilt" ), matcher.MatchesTagName( TEXT( "Mission.Dialog" ) ) );
+
+    matcher.Reset();
+    TestTrue( TEXT( "The matcher is empty once reset" ), matcher.IsEmpty() );
+
+    return true;
+}
+
+#endif
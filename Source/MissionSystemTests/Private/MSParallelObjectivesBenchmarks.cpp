@@ -0,0 +1,123 @@
+#include "MSBenchmarkReport.h"
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestMissionGraph.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // Missions x Objectives per mission x Actions per step
+    const FMSTestMissionGraphParameters ParallelObjectivesBenchmarkScales[] = {
+        { 10, 100, 2 },
+        { 100, 100, 2 },
+    };
+
+    constexpr auto ParallelObjectivesIterationCount = 10;
+    constexpr auto ParallelGroupSize = 10;
+
+    void SetParallelGroupSize( const TArray< UMSMissionData * > & missions, const int32 group_size )
+    {
+        for ( auto * mission_data : missions )
+        {
+            for ( auto index = 0; index < mission_data->Objectives.Num(); ++index )
+            {
+                mission_data->Objectives[ index ].bStartWithPreviousObjective = index % group_size != 0;
+            }
+
+            mission_data->CompileObjectiveDependencies();
+        }
+    }
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST( FMSParallelObjectivesBenchmark, "MissionSystem.Benchmarks.ParallelObjectives", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter )
+
+void FMSParallelObjectivesBenchmark::GetTests( TArray< FString > & out_beautified_names, TArray< FString > & out_test_commands ) const
+{
+    for ( const auto & parameters : ParallelObjectivesBenchmarkScales )
+    {
+        out_beautified_names.Add( parameters.ToString() );
+        out_test_commands.Add( parameters.ToString() );
+    }
+}
+
+bool FMSParallelObjectivesBenchmark::RunTest( const FString & parameters_string )
+{
+    FMSTestMissionGraphParameters parameters( 0, 0, 0 );
+    if ( !FMSTestMissionGraphParameters::Parse( parameters_string, parameters ) )
+    {
+        AddError( FString::Printf( TEXT( "Invalid benchmark parameters : %s" ), *parameters_string ) );
+        return false;
+    }
+
+    const FMSTestMissionGraph graph( parameters );
+    const auto & missions = graph.GetMissions();
+    const auto metric_prefix = parameters.ToString();
+
+    FMSBenchmarkReport report( *this );
+
+    // Runs all the missions to completion, with the objectives started one at a time or by groups of ParallelGroupSize
+    const auto measure_mission_cycle = [ & ]( const int32 group_size ) {
+        SetParallelGroupSize( missions, group_size );
+
+        auto * component = graph.CreateComponent();
+
+        for ( auto * mission_data : missions )
+        {
+            component->StartMission( mission_data );
+        }
+
+        const auto & history = component->GetMissionHistory();
+
+        for ( auto mission_index = 0; mission_index < missions.Num(); ++mission_index )
+        {
+            const auto objectives = graph.GetObjectives( mission_index );
+
+            for ( auto objective_index = 0; objective_index < objectives.Num(); ++objective_index )
+            {
+                if ( history.IsObjectiveActive( objectives[ objective_index ] ) != ( objective_index < group_size ) )
+                {
+                    AddError( FString::Printf( TEXT( "Only the objectives of the first group are active when the mission starts (objective %d, groups of %d)" ), objective_index, group_size ) );
+                    break;
+                }
+            }
+        }
+
+        // The missions started by the check are still active, so the measures run on a new component
+        FMSTestMissionGraph::DestroyComponent( component );
+        component = graph.CreateComponent();
+
+        report.Measure(
+            metric_prefix + ( group_size > 1 ? TEXT( ".MissionCycle.Parallel" ) : TEXT( ".MissionCycle.Sequential" ) ),
+            ParallelObjectivesIterationCount,
+            [ & ]() {
+                component->ClearMissionHistory();
+            },
+            [ & ]() {
+                for ( auto * mission_data : missions )
+                {
+                    component->StartMission( mission_data );
+                }
+
+                graph.CompleteObjectives( component, parameters.ObjectivesPerMission );
+            } );
+
+        for ( auto * mission_data : missions )
+        {
+            TestTrue( TEXT( "The mission is complete after all its objectives have been completed" ), component->IsMissionComplete( mission_data ) );
+        }
+
+        FMSTestMissionGraph::DestroyComponent( component );
+    };
+
+    measure_mission_cycle( 1 );
+    measure_mission_cycle( ParallelGroupSize );
+
+    SetParallelGroupSize( missions, 1 );
+
+    return report.CompareAndSave();
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "MSMission.h"
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestMissionGraph.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FMSParallelObjectivesTest, "MissionSystem.Objectives.ParallelGroups", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter )
+
+bool FMSParallelObjectivesTest::RunTest( const FString & /*parameters*/ )
+{
+    const FMSTestMissionGraph graph( FMSTestMissionGraphParameters( 3, 3, 0 ) );
+
+    // ( 0, 1 ) -> 2
+    for ( auto * mission_data : graph.GetMissions() )
+    {
+        mission_data->Objectives[ 1 ].bStartWithPreviousObjective = true;
+        mission_data->CompileObjectiveDependencies();
+    }
+
+    auto * component = graph.CreateComponent();
+    const auto & history = component->GetMissionHistory();
+
+    const auto test_active_objectives = [ & ]( const int32 mission_index, const TCHAR * step, const TArray< bool > & expected_active_objectives ) {
+        const auto objectives = graph.GetObjectives( mission_index );
+
+        for ( auto index = 0; index < objectives.Num(); ++index )
+        {
+            TestEqual( FString::Printf( TEXT( "Mission %d - %s : objective %d is active" ), mission_index, step, index ), history.IsObjectiveActive( objectives[ index ] ), expected_active_objectives[ index ] );
+        }
+    };
+
+    const auto cancel_objective = [ & ]( const UMSMissionData * mission_data, const TSubclassOf< UMSMissionObjective > & objective_class ) {
+        if ( const auto * mission = component->GetActiveMission( mission_data ) )
+        {
+            for ( auto * objective : mission->GetObjectives() )
+            {
+                if ( objective->GetClass() == objective_class )
+                {
+                    objective->CancelObjective();
+                    return;
+                }
+            }
+        }
+
+        AddError( FString::Printf( TEXT( "%s is not active" ), *objective_class->GetName() ) );
+    };
+
+    // The next group starts once the last member of the group has completed
+    {
+        auto * mission_data = graph.GetMissions()[ 0 ];
+        const auto objectives = graph.GetObjectives( 0 );
+
+        component->StartMission( mission_data );
+        test_active_objectives( 0, TEXT( "Mission started" ), { true, true, false } );
+
+        component->CompleteObjective( mission_data, objectives[ 1 ] );
+        test_active_objectives( 0, TEXT( "Objective 1 completed" ), { true, false, false } );
+
+        component->CompleteObjective( mission_data, objectives[ 0 ] );
+        test_active_objectives( 0, TEXT( "Objective 0 completed" ), { false, false, true } );
+
+        component->CompleteObjective( mission_data, objectives[ 2 ] );
+        TestTrue( TEXT( "The mission is complete once all its objectives have been completed" ), component->IsMissionComplete( mission_data ) );
+    }
+
+    // A cancelled member stops the mission, like a cancelled objective of a mission which runs its objectives one at a time,
+    // whether it is the last member of its group to end or not
+    {
+        auto * mission_data = graph.GetMissions()[ 1 ];
+        const auto objectives = graph.GetObjectives( 1 );
+
+        component->StartMission( mission_data );
+        component->CompleteObjective( mission_data, objectives[ 0 ] );
+        cancel_objective( mission_data, objectives[ 1 ] );
+
+        TestTrue( TEXT( "The cancelled objective is saved in the history" ), history.IsObjectiveCancelled( objectives[ 1 ] ) );
+        test_active_objectives( 1, TEXT( "Last member cancelled" ), { false, false, false } );
+        TestTrue( TEXT( "The mission stays active when the last member of a group is cancelled" ), component->IsMissionActive( mission_data ) );
+    }
+
+    {
+        auto * mission_data = graph.GetMissions()[ 2 ];
+        const auto objectives = graph.GetObjectives( 2 );
+
+        component->StartMission( mission_data );
+        cancel_objective( mission_data, objectives[ 0 ] );
+        component->CompleteObjective( mission_data, objectives[ 1 ] );
+
+        test_active_objectives( 2, TEXT( "First member cancelled" ), { false, false, false } );
+        TestTrue( TEXT( "The mission stays active when a member of a group is cancelled before the others complete" ), component->IsMissionActive( mission_data ) );
+    }
+
+    component->CancelCurrentMissions();
+    FMSTestMissionGraph::DestroyComponent( component );
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,300 @@
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestMissionGraph.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include <Editor.h>
+#include <Engine/NetConnection.h>
+#include <Engine/World.h>
+#include <GameFramework/PlayerController.h>
+#include <Settings/LevelEditorPlaySettings.h>
+#include <UObject/StrongObjectPtr.h>
+
+namespace
+{
+    // Missions x Objectives per mission x Actions per step
+    const FMSTestMissionGraphParameters ReplicationBandwidthScales[] = {
+        { 10, 10, 1 },
+        { 100, 10, 1 },
+    };
+
+    constexpr auto ReplicationTimeout = 30.0;
+
+    /* Shared by the latent commands of a run of the bandwidth test */
+    struct FMSReplicationBandwidthContext
+    {
+        explicit FMSReplicationBandwidthContext( FAutomationTestBase & test, const FMSTestMissionGraphParameters & parameters ) :
+            Test( test ),
+            Graph( parameters ),
+            bFailed( false )
+        {
+        }
+
+        FAutomationTestBase & Test;
+        FMSTestMissionGraph Graph;
+        TStrongObjectPtr< ULevelEditorPlaySettings > PlaySettings;
+        TWeakObjectPtr< UMSMissionSystemComponent > ServerComponent;
+        TWeakObjectPtr< UMSMissionSystemComponent > ClientComponent;
+        TWeakObjectPtr< UNetConnection > Connection;
+        TMap< FString, int64 > SentBytes;
+        bool bFailed;
+    };
+
+    UWorld * FindPIEWorld( const ENetMode net_mode )
+    {
+        for ( const auto & world_context : GEngine->GetWorldContexts() )
+        {
+            auto * world = world_context.World();
+
+            if ( world_context.WorldType == EWorldType::PIE && world != nullptr && world->GetNetMode() == net_mode )
+            {
+                return world;
+            }
+        }
+
+        return nullptr;
+    }
+
+    APlayerController * FindRemotePlayerController( UWorld * server_world )
+    {
+        for ( auto ite = server_world->GetPlayerControllerIterator(); ite; ++ite )
+        {
+            if ( auto * player_controller = ite->Get(); player_controller != nullptr && !player_controller->IsLocalController() )
+            {
+                return player_controller;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool IsClientInSync( const FMSReplicationBandwidthContext & context )
+    {
+        const auto * server_component = context.ServerComponent.Get();
+        const auto * client_component = context.ClientComponent.Get();
+
+        if ( server_component == nullptr || client_component == nullptr )
+        {
+            return false;
+        }
+
+        const auto & server_history = server_component->GetMissionHistory();
+        const auto & client_history = client_component->GetMissionHistory();
+        const auto & missions = context.Graph.GetMissions();
+
+        for ( auto mission_index = 0; mission_index < missions.Num(); ++mission_index )
+        {
+            auto * mission_data = missions[ mission_index ];
+
+            if ( server_history.IsMissionActive( mission_data ) != client_history.IsMissionActive( mission_data )
+                 || server_history.IsMissionComplete( mission_data ) != client_history.IsMissionComplete( mission_data ) )
+            {
+                return false;
+            }
+
+            for ( const auto & objective : context.Graph.GetObjectives( mission_index ) )
+            {
+                if ( server_history.IsObjectiveActive( objective ) != client_history.IsObjectiveActive( objective )
+                     || server_history.IsObjectiveComplete( objective ) != client_history.IsObjectiveComplete( objective ) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Returns a latent command which polls condition until it returns true, or fails the test after ReplicationTimeout
+    template < typename _ConditionType_ >
+    TFunction< bool() > WaitUntil( const TSharedRef< FMSReplicationBandwidthContext > & context, const FString & description, _ConditionType_ && condition )
+    {
+        return [ context, description, condition = MoveTemp( condition ), start_time = 0.0 ]() mutable {
+            if ( context->bFailed )
+            {
+                return true;
+            }
+
+            if ( start_time == 0.0 )
+            {
+                start_time = FPlatformTime::Seconds();
+            }
+
+            if ( condition() )
+            {
+                return true;
+            }
+
+            if ( FPlatformTime::Seconds() - start_time > ReplicationTimeout )
+            {
+                context->Test.AddError( FString::Printf( TEXT( "Timed out while waiting for %s" ), *description ) );
+                context->bFailed = true;
+                return true;
+            }
+
+            return false;
+        };
+    }
+
+    // Returns a latent command which runs step on the server, then waits for the client to be in sync and records the bytes sent to the client meanwhile
+    template < typename _StepType_ >
+    TFunction< bool() > MeasureStep( const TSharedRef< FMSReplicationBandwidthContext > & context, const FString & step_name, _StepType_ && step )
+    {
+        auto wait_for_client = WaitUntil( context, step_name, [ context ]() {
+            return IsClientInSync( *context );
+        } );
+
+        return [ context, step_name, step = MoveTemp( step ), wait_for_client = MoveTemp( wait_for_client ), start_bytes = static_cast< int64 >( INDEX_NONE ) ]() mutable {
+            if ( context->bFailed )
+            {
+                return true;
+            }
+
+            auto * connection = context->Connection.Get();
+            auto * server_component = context->ServerComponent.Get();
+
+            if ( connection == nullptr || server_component == nullptr )
+            {
+                context->Test.AddError( FString::Printf( TEXT( "The client disconnected before %s" ), *step_name ) );
+                context->bFailed = true;
+                return true;
+            }
+
+            if ( start_bytes == INDEX_NONE )
+            {
+                start_bytes = connection->OutTotalBytes;
+                step( *server_component );
+            }
+
+            if ( !wait_for_client() )
+            {
+                return false;
+            }
+
+            const auto sent_bytes = static_cast< int64 >( connection->OutTotalBytes ) - start_bytes;
+            context->SentBytes.Add( step_name, sent_bytes );
+            context->Test.AddInfo( FString::Printf( TEXT( "%s : %lld bytes sent to the client" ), *step_name, sent_bytes ) );
+
+            return true;
+        };
+    }
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST( FMSReplicationBandwidthTest, "MissionSystem.Benchmarks.ReplicationBandwidth", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter )
+
+void FMSReplicationBandwidthTest::GetTests( TArray< FString > & out_beautified_names, TArray< FString > & out_test_commands ) const
+{
+    for ( const auto & parameters : ReplicationBandwidthScales )
+    {
+        out_beautified_names.Add( parameters.ToString() );
+        out_test_commands.Add( parameters.ToString() );
+    }
+}
+
+bool FMSReplicationBandwidthTest::RunTest( const FString & parameters_string )
+{
+    FMSTestMissionGraphParameters parameters( 0, 0, 0 );
+    if ( !FMSTestMissionGraphParameters::Parse( parameters_string, parameters ) )
+    {
+        AddError( FString::Printf( TEXT( "Invalid benchmark parameters : %s" ), *parameters_string ) );
+        return false;
+    }
+
+    if ( GEditor == nullptr || GEditor->IsPlaySessionInProgress() )
+    {
+        AddError( TEXT( "The replication bandwidth test requires the editor, without a play session in progress" ) );
+        return false;
+    }
+
+    const auto context = MakeShared< FMSReplicationBandwidthContext >( *this, parameters );
+
+    // A listen server, which is the first player, and a remote client, both in the editor process
+    context->PlaySettings.Reset( DuplicateObject( GetDefault< ULevelEditorPlaySettings >(), GetTransientPackage() ) );
+    context->PlaySettings->SetPlayNetMode( PIE_ListenServer );
+    context->PlaySettings->SetPlayNumberOfClients( 2 );
+    context->PlaySettings->SetRunUnderOneProcess( true );
+    context->PlaySettings->bLaunchSeparateServer = false;
+
+    FRequestPlaySessionParams play_session_parameters;
+    play_session_parameters.WorldType = EPlaySessionWorldType::PlayInEditor;
+    play_session_parameters.EditorPlaySettings = context->PlaySettings.Get();
+    GEditor->RequestPlaySession( play_session_parameters );
+
+    ADD_LATENT_AUTOMATION_COMMAND( FFunctionLatentCommand( WaitUntil( context, TEXT( "the client to connect" ), [ context ]() {
+        auto * server_world = FindPIEWorld( NM_ListenServer );
+        auto * client_world = FindPIEWorld( NM_Client );
+
+        if ( server_world == nullptr || client_world == nullptr || client_world->GetFirstPlayerController() == nullptr )
+        {
+            return false;
+        }
+
+        auto * player_controller = FindRemotePlayerController( server_world );
+
+        if ( player_controller == nullptr || player_controller->GetNetConnection() == nullptr )
+        {
+            return false;
+        }
+
+        auto * component = NewObject< UMSMissionSystemComponent >( player_controller );
+        component->RegisterComponent();
+
+        context->ServerComponent = component;
+        context->Connection = player_controller->GetNetConnection();
+        return true;
+    } ) ) );
+
+    ADD_LATENT_AUTOMATION_COMMAND( FFunctionLatentCommand( WaitUntil( context, TEXT( "the component to replicate" ), [ context ]() {
+        auto * client_world = FindPIEWorld( NM_Client );
+        auto * player_controller = client_world != nullptr ? client_world->GetFirstPlayerController() : nullptr;
+
+        context->ClientComponent = player_controller != nullptr ? player_controller->FindComponentByClass< UMSMissionSystemComponent >() : nullptr;
+        return context->ClientComponent.IsValid();
+    } ) ) );
+
+    ADD_LATENT_AUTOMATION_COMMAND( FFunctionLatentCommand( MeasureStep( context, TEXT( "StartMissions" ), [ context ]( UMSMissionSystemComponent & component ) {
+        for ( auto * mission_data : context->Graph.GetMissions() )
+        {
+            component.StartMission( mission_data );
+        }
+    } ) ) );
+
+    ADD_LATENT_AUTOMATION_COMMAND( FFunctionLatentCommand( MeasureStep( context, TEXT( "CompleteOneObjective" ), [ context ]( UMSMissionSystemComponent & component ) {
+        component.CompleteObjective( context->Graph.GetMissions()[ 0 ], context->Graph.GetObjectives( 0 )[ 0 ] );
+    } ) ) );
+
+    ADD_LATENT_AUTOMATION_COMMAND( FFunctionLatentCommand( MeasureStep( context, TEXT( "CompleteAllObjectives" ), [ context ]( UMSMissionSystemComponent & component ) {
+        context->Graph.CompleteObjectives( &component, context->Graph.GetParameters().ObjectivesPerMission );
+    } ) ) );
+
+    ADD_LATENT_AUTOMATION_COMMAND( FFunctionLatentCommand( [ context ]() {
+        if ( !context->bFailed )
+        {
+            const auto start_missions_bytes = context->SentBytes.FindRef( TEXT( "StartMissions" ) );
+            const auto one_objective_bytes = context->SentBytes.FindRef( TEXT( "CompleteOneObjective" ) );
+
+            // Completing a single objective must only send the states which changed, not the whole history
+            context->Test.TestTrue( TEXT( "Only the delta is sent to the client" ), one_objective_bytes < start_missions_bytes );
+
+            for ( auto * mission_data : context->Graph.GetMissions() )
+            {
+                const auto * client_component = context->ClientComponent.Get();
+                context->Test.TestTrue( TEXT( "The client sees the mission as complete" ), client_component != nullptr && client_component->GetMissionHistory().IsMissionComplete( mission_data ) );
+            }
+        }
+
+        GEditor->RequestEndPlayMap();
+        return true;
+    } ) );
+
+    ADD_LATENT_AUTOMATION_COMMAND( FFunctionLatentCommand( [ context ]() {
+        return !GEditor->IsPlaySessionInProgress();
+    } ) );
+
+    return true;
+}
+
+#endif
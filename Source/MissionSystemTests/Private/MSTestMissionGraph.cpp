@@ -0,0 +1,190 @@
+#include "MSTestMissionGraph.h"
+
+#include "MSMissionCatalogSubsystem.h"
+#include "MSMissionData.h"
+#include "MSMissionSystemComponent.h"
+#include "MSTestTypes.h"
+
+#include <UObject/Package.h>
+
+namespace
+{
+    /* Each objective needs its own class, because the mission history identifies objectives by the GUID of their CDO.
+     Creating thousands of classes is slow, so they are shared by all the graphs and kept alive until the module is unloaded
+     */
+    class FMSTestObjectiveClassCache
+    {
+    public:
+        static FMSTestObjectiveClassCache & Get()
+        {
+            static FMSTestObjectiveClassCache instance;
+            return instance;
+        }
+
+        TSubclassOf< UMSMissionObjective > GetClass( const int32 index )
+        {
+            while ( Classes.Num() <= index )
+            {
+                Classes.Add( CreateClass( Classes.Num() ) );
+            }
+
+            return Classes[ index ];
+        }
+
+    private:
+        static UClass * CreateClass( const int32 index )
+        {
+            auto * parent_class = UMSTestObjective::StaticClass();
+            auto * objective_class = NewObject< UClass >( GetTransientPackage(), *FString::Printf( TEXT( "MSTestObjective_%d" ), index ), RF_Public | RF_Transient );
+
+            objective_class->SetSuperStruct( parent_class );
+            objective_class->ClassFlags |= parent_class->ClassFlags & CLASS_Inherit;
+            objective_class->ClassCastFlags |= parent_class->ClassCastFlags;
+            objective_class->ClassWithin = parent_class->ClassWithin;
+            objective_class->ClassConfigName = parent_class->ClassConfigName;
+            objective_class->Bind();
+            objective_class->StaticLink( true );
+            objective_class->AssembleReferenceTokenStream( true );
+            objective_class->AddToRoot();
+
+            auto * cdo = objective_class->GetDefaultObject< UMSTestObjective >();
+            cdo->SetObjectiveId( FGuid::NewGuid() );
+
+            return objective_class;
+        }
+
+        TArray< UClass * > Classes;
+    };
+}
+
+FMSTestMissionGraphParameters::FMSTestMissionGraphParameters( const int32 mission_count, const int32 objectives_per_mission, const int32 actions_per_step ) :
+    MissionCount( mission_count ),
+    ObjectivesPerMission( objectives_per_mission ),
+    ActionsPerStep( actions_per_step )
+{
+}
+
+bool FMSTestMissionGraphParameters::Parse( const FString & parameters_string, FMSTestMissionGraphParameters & parameters )
+{
+    TArray< FString > tokens;
+    parameters_string.ParseIntoArray( tokens, TEXT( "x" ) );
+
+    if ( tokens.Num() != 3 )
+    {
+        return false;
+    }
+
+    parameters.MissionCount = FCString::Atoi( *tokens[ 0 ] );
+    parameters.ObjectivesPerMission = FCString::Atoi( *tokens[ 1 ] );
+    parameters.ActionsPerStep = FCString::Atoi( *tokens[ 2 ] );
+
+    return parameters.MissionCount > 0 && parameters.ObjectivesPerMission > 0 && parameters.ActionsPerStep >= 0;
+}
+
+FString FMSTestMissionGraphParameters::ToString() const
+{
+    return FString::Printf( TEXT( "%dx%dx%d" ), MissionCount, ObjectivesPerMission, ActionsPerStep );
+}
+
+int32 FMSTestMissionGraphParameters::GetObjectiveCount() const
+{
+    return MissionCount * ObjectivesPerMission;
+}
+
+FMSTestMissionGraph::FMSTestMissionGraph( const FMSTestMissionGraphParameters & parameters ) :
+    Parameters( parameters )
+{
+    auto & class_cache = FMSTestObjectiveClassCache::Get();
+
+    // Transient missions are unknown to the asset registry. Register them so they can be resumed from the history
+    auto * catalog = UMSMissionCatalogSubsystem::Get();
+    check( catalog != nullptr );
+
+    Missions.Reserve( Parameters.MissionCount );
+    Objectives.Reserve( Parameters.GetObjectiveCount() );
+
+    for ( auto mission_index = 0; mission_index < Parameters.MissionCount; ++mission_index )
+    {
+        auto * mission_data = NewObject< UMSMissionData >( GetTransientPackage(), NAME_None, RF_Transient );
+        mission_data->AddToRoot();
+        RootedObjects.Add( mission_data );
+
+        mission_data->MissionId = FGuid::NewGuid();
+        catalog->AddMissionData( mission_data );
+        mission_data->StartActions.Append( CreateActions( mission_data ) );
+        mission_data->EndActions.Append( CreateActions( mission_data ) );
+
+        for ( auto objective_index = 0; objective_index < Parameters.ObjectivesPerMission; ++objective_index )
+        {
+            const auto objective_class = class_cache.GetClass( Objectives.Num() );
+
+            auto * cdo = objective_class->GetDefaultObject< UMSTestObjective >();
+            cdo->SetActions( CreateActions( cdo ), CreateActions( cdo ) );
+
+            mission_data->Objectives.Emplace( objective_class );
+            Objectives.Add( objective_class );
+        }
+
+        Missions.Add( mission_data );
+    }
+}
+
+FMSTestMissionGraph::~FMSTestMissionGraph()
+{
+    for ( auto * object : RootedObjects )
+    {
+        object->RemoveFromRoot();
+        object->MarkAsGarbage();
+    }
+}
+
+TConstArrayView< TSubclassOf< UMSMissionObjective > > FMSTestMissionGraph::GetObjectives( const int32 mission_index ) const
+{
+    return MakeArrayView( Objectives ).Slice( mission_index * Parameters.ObjectivesPerMission, Parameters.ObjectivesPerMission );
+}
+
+UMSMissionSystemComponent * FMSTestMissionGraph::CreateComponent() const
+{
+    auto * component = NewObject< UMSMissionSystemComponent >( GetTransientPackage(), NAME_None, RF_Transient );
+    component->AddToRoot();
+    return component;
+}
+
+void FMSTestMissionGraph::DestroyComponent( UMSMissionSystemComponent * component )
+{
+    if ( component != nullptr )
+    {
+        component->RemoveFromRoot();
+        component->MarkAsGarbage();
+    }
+}
+
+void FMSTestMissionGraph::CompleteObjectives( UMSMissionSystemComponent * component, const int32 objectives_to_complete ) const
+{
+    for ( auto mission_index = 0; mission_index < Missions.Num(); ++mission_index )
+    {
+        const auto objectives = GetObjectives( mission_index );
+        const auto count = FMath::Min( objectives_to_complete, objectives.Num() );
+
+        for ( auto objective_index = 0; objective_index < count; ++objective_index )
+        {
+            component->CompleteObjective( Missions[ mission_index ], objectives[ objective_index ] );
+        }
+    }
+}
+
+TArray< UMSMissionAction * > FMSTestMissionGraph::CreateActions( UObject * outer )
+{
+    TArray< UMSMissionAction * > actions;
+    actions.Reserve( Parameters.ActionsPerStep );
+
+    for ( auto index = 0; index < Parameters.ActionsPerStep; ++index )
+    {
+        auto * action = NewObject< UMSTestInstantAction >( outer, NAME_None, RF_Transient );
+        action->AddToRoot();
+        RootedObjects.Add( action );
+        actions.Add( action );
+    }
+
+    return actions;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Templates/SubclassOf.h>
+
+class UMSMissionAction;
+class UMSMissionData;
+class UMSMissionObjective;
+class UMSMissionSystemComponent;
+
+struct FMSTestMissionGraphParameters
+{
+    FMSTestMissionGraphParameters( int32 mission_count, int32 objectives_per_mission, int32 actions_per_step );
+
+    static bool Parse( const FString & parameters_string, FMSTestMissionGraphParameters & parameters );
+    FString ToString() const;
+    int32 GetObjectiveCount() const;
+
+    int32 MissionCount;
+    int32 ObjectivesPerMission;
+
+    // Number of instant actions added to each start and end action list, for the missions and for the objectives
+    int32 ActionsPerStep;
+};
+
+/* Generates transient mission data, with unique objective classes, to drive the mission system in automation tests
+ All the objects are rooted for the lifetime of the graph
+ */
+class FMSTestMissionGraph
+{
+public:
+    explicit FMSTestMissionGraph( const FMSTestMissionGraphParameters & parameters );
+    ~FMSTestMissionGraph();
+
+    const FMSTestMissionGraphParameters & GetParameters() const;
+    const TArray< UMSMissionData * > & GetMissions() const;
+    TConstArrayView< TSubclassOf< UMSMissionObjective > > GetObjectives( int32 mission_index ) const;
+
+    UMSMissionSystemComponent * CreateComponent() const;
+    static void DestroyComponent( UMSMissionSystemComponent * component );
+
+    // Completes the first objectives_to_complete objectives of every mission
+    void CompleteObjectives( UMSMissionSystemComponent * component, int32 objectives_to_complete ) const;
+
+private:
+    TArray< UMSMissionAction * > CreateActions( UObject * outer );
+
+    FMSTestMissionGraphParameters Parameters;
+    TArray< UMSMissionData * > Missions;
+    TArray< TSubclassOf< UMSMissionObjective > > Objectives;
+    TArray< UObject * > RootedObjects;
+};
+
+FORCEINLINE const FMSTestMissionGraphParameters & FMSTestMissionGraph::GetParameters() const
+{
+    return Parameters;
+}
+
+FORCEINLINE const TArray< UMSMissionData * > & FMSTestMissionGraph::GetMissions() const
+{
+    return Missions;
+}
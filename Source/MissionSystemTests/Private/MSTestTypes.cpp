@@ -0,0 +1,55 @@
+#include "MSTestTypes.h"
+
+namespace
+{
+    TArray< TWeakObjectPtr< UMSTestLatentAction > > ExecutingLatentActions;
+}
+
+void UMSTestObjective::SetObjectiveId( const FGuid & objective_id )
+{
+    ObjectiveId = objective_id;
+}
+
+void UMSTestObjective::SetActions( const TArray< UMSMissionAction * > & start_actions, const TArray< UMSMissionAction * > & end_actions )
+{
+    StartActions.Reset();
+    StartActions.Append( start_actions );
+
+    EndActions.Reset();
+    EndActions.Append( end_actions );
+}
+
+void UMSTestInstantAction::Execute_Implementation()
+{
+    FinishExecute();
+}
+
+int32 UMSTestLatentAction::GetExecutingActionCount()
+{
+    return ExecutingLatentActions.Num();
+}
+
+void UMSTestLatentAction::FinishExecutingActions()
+{
+    // Finishing an action can execute other latent actions, which wait for the next call
+    const auto actions = MoveTemp( ExecutingLatentActions );
+    ExecutingLatentActions.Reset();
+
+    for ( const auto & action : actions )
+    {
+        if ( action.IsValid() )
+        {
+            action->FinishExecute();
+        }
+    }
+}
+
+void UMSTestLatentAction::SetPipelineBarrier( const bool is_pipeline_barrier )
+{
+    bIsPipelineBarrier = is_pipeline_barrier;
+}
+
+void UMSTestLatentAction::Execute_Implementation()
+{
+    ExecutingLatentActions.Add( this );
+}
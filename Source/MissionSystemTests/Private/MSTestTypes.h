@@ -0,0 +1,43 @@
+#pragma once
+
+#include "MSMissionAction.h"
+#include "MSMissionObjective.h"
+
+#include <CoreMinimal.h>
+
+#include "MSTestTypes.generated.h"
+
+/* Objective used by the automation tests. It does nothing when executed, and waits for CompleteObjective to be called */
+UCLASS( NotBlueprintable, Transient )
+class UMSTestObjective : public UMSMissionObjective
+{
+    GENERATED_BODY()
+
+public:
+    void SetObjectiveId( const FGuid & objective_id );
+    void SetActions( const TArray< UMSMissionAction * > & start_actions, const TArray< UMSMissionAction * > & end_actions );
+};
+
+/* Action used by the automation tests. It finishes as soon as it is executed */
+UCLASS( NotBlueprintable, Transient )
+class UMSTestInstantAction : public UMSMissionAction
+{
+    GENERATED_BODY()
+
+public:
+    void Execute_Implementation() override;
+};
+
+/* Action used by the automation tests. It waits for FinishExecutingActions to be called */
+UCLASS( NotBlueprintable, Transient )
+class UMSTestLatentAction : public UMSMissionAction
+{
+    GENERATED_BODY()
+
+public:
+    static int32 GetExecutingActionCount();
+    static void FinishExecutingActions();
+
+    void SetPipelineBarrier( bool is_pipeline_barrier );
+    void Execute_Implementation() override;
+};